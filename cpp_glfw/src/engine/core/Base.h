@@ -7,8 +7,11 @@
 #include <climits>
 #include <cstdint>
 #include <cfloat>
+#include <cmath>
+#include <cstring>
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <algorithm>
 #include <malloc.h>
 
@@ -144,18 +147,54 @@ typedef void (*GLProc)(void);
 #define GL_CONTEXT_RELEASE_BEHAVIOR 0x82fb
 #define GL_CONTEXT_RELEASE_BEHAVIOR_FLUSH 0x82fc
 #define GL_CONTEXT_FLAG_NO_ERROR_BIT_KHR 0x00000008
+#define GL_RGBA 0x1908
+#define GL_PIXEL_PACK_BUFFER 0x88eb
+#define GL_PIXEL_PACK_BUFFER_BINDING 0x88ed
+#define GL_STREAM_READ 0x88e1
+#define GL_READ_ONLY 0x88b8
+#define GL_MAP_READ_BIT 0x0001
+#define GL_READ_FRAMEBUFFER 0x8ca8
+#define GL_READ_FRAMEBUFFER_BINDING 0x8caa
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_ALREADY_SIGNALED 0x911a
+#define GL_CONDITION_SATISFIED 0x911c
 
 typedef int GLint;
 typedef unsigned int GLuint;
 typedef unsigned int GLenum;
 typedef unsigned int GLbitfield;
 typedef unsigned char GLubyte;
+typedef unsigned char GLboolean;
+typedef int GLsizei;
+//same as khrplatform.h, so the types match the ones of an OpenGL loader included after this header
+#if defined(_WIN64)
+typedef signed long long int GLintptr;
+typedef signed long long int GLsizeiptr;
+#else
+typedef signed long int GLintptr;
+typedef signed long int GLsizeiptr;
+#endif
+typedef uint64_t GLuint64;
+typedef struct __GLsync* GLsync;
 
 //function pointer typedefs from glcorearb.h
 typedef void (APIENTRY* PFNGLCLEARPROC)(GLbitfield mask);
 typedef const GLubyte* (APIENTRY* PFNGLGETSTRINGPROC)(GLenum name);
 typedef void (APIENTRY* PFNGLGETINTEGERVPROC)(GLenum pname, GLint* data);
 typedef const GLubyte* (APIENTRY* PFNGLGETSTRINGIPROC)(GLenum name, GLuint index);
+typedef void (APIENTRY* PFNGLREADPIXELSPROC)(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels);
+typedef void (APIENTRY* PFNGLGENBUFFERSPROC)(GLsizei n, GLuint* buffers);
+typedef void (APIENTRY* PFNGLDELETEBUFFERSPROC)(GLsizei n, const GLuint* buffers);
+typedef void (APIENTRY* PFNGLBINDBUFFERPROC)(GLenum target, GLuint buffer);
+typedef void (APIENTRY* PFNGLBUFFERDATAPROC)(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+typedef void* (APIENTRY* PFNGLMAPBUFFERPROC)(GLenum target, GLenum access);
+typedef void* (APIENTRY* PFNGLMAPBUFFERRANGEPROC)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+typedef GLboolean (APIENTRY* PFNGLUNMAPBUFFERPROC)(GLenum target);
+typedef void (APIENTRY* PFNGLBINDFRAMEBUFFERPROC)(GLenum target, GLuint framebuffer);
+typedef GLsync (APIENTRY* PFNGLFENCESYNCPROC)(GLenum condition, GLbitfield flags);
+typedef GLenum (APIENTRY* PFNGLCLIENTWAITSYNCPROC)(GLsync sync, GLbitfield flags, GLuint64 timeout);
+typedef void (APIENTRY* PFNGLDELETESYNCPROC)(GLsync sync);
 
 
 #if defined(_WIN32)
@@ -276,6 +315,7 @@ struct Image
 };
 
 #include "engine/core/Utils.h"
+#include "engine/core/Memory.h"
 
 namespace cpp_glfw
 {
@@ -284,7 +324,8 @@ namespace cpp_glfw
     {
         None = 0,
         OpenGL = 1,
-        OpenGLES = 2
+        OpenGLES = 2,
+        Software = 3 //CPU pixel buffer presented by the window system, no OpenGL context
     };
 
     enum class ContextType
@@ -467,6 +467,13 @@ namespace cpp_glfw
             return;
         }
 
+        if (window
+            && window->m_Context->m_API == ContextAPI::Software)
+        {
+            CPP_GLFW_ERROR("Cannot make current with a window that has a software framebuffer!");
+            return;
+        }
+
         if (previous)
         {
             if (!window
@@ -504,7 +511,18 @@ namespace cpp_glfw
             return;
         }
 
-        if (window->m_Context->m_Type == ContextType::Native)
+        //the back buffer contents are undefined after the swap, so the capture reads them first
+        if (window->m_Context->m_Capture
+            && GetCurrentContext() == window)
+        {
+            window->m_Context->m_Capture->Capture(window);
+        }
+
+        if (window->m_Context->m_API == ContextAPI::Software)
+        {
+            PlatformSwapSoftwareBuffers(window);
+        }
+        else if (window->m_Context->m_Type == ContextType::Native)
         {
             PlatformSwapBuffers(window);
         }
@@ -623,7 +641,23 @@ namespace cpp_glfw
             return;
         }
 
-        if (window->m_Context->m_Type == ContextType::Native)
+        if (window->m_Context->m_Capture)
+        {
+            //if the context is not current the buffers are released along with it
+            if (GetCurrentContext() == window)
+            {
+                window->m_Context->m_Capture->Finish(window);
+            }
+
+            delete window->m_Context->m_Capture;
+            window->m_Context->m_Capture = nullptr;
+        }
+
+        if (window->m_Context->m_API == ContextAPI::Software)
+        {
+            PlatformDestroySoftwareContext(window);
+        }
+        else if (window->m_Context->m_Type == ContextType::Native)
         {
             PlatformDestroyContext(window);
         }
@@ -632,4 +666,85 @@ namespace cpp_glfw
             EglContext::DestroyContext(window);
         }
     }
+
+    /// <summary> The returned pixels stay valid until the next SwapBuffers or until the window is resized </summary>
+    bool Context::GetSoftwareFramebuffer(Window* window, SoftwareFramebuffer* framebuffer)
+    {
+        if (window->m_Context->m_API != ContextAPI::Software)
+        {
+            CPP_GLFW_ERROR("Cannot get the software framebuffer of a window that was not created with ContextAPI::Software!");
+            return false;
+        }
+
+        return PlatformGetSoftwareFramebuffer(window, framebuffer);
+    }
+
+    /// <summary> Limits the next SwapBuffers to the damaged rects, without any damage the whole framebuffer is presented </summary>
+    void Context::AddDamageRect(Window* window, int32_t x, int32_t y, int32_t width, int32_t height)
+    {
+        if (window->m_Context->m_API != ContextAPI::Software)
+        {
+            CPP_GLFW_ERROR("Cannot add damage to a window that was not created with ContextAPI::Software!");
+            return;
+        }
+
+        if (width <= 0
+            || height <= 0)
+        {
+            return;
+        }
+
+        PlatformAddDamageRect(window, x, y, width, height);
+    }
+
+    /// <summary>
+    /// Starts delivering every frame of the window to the callback, latency swaps after it was rendered at the latest.
+    /// The window's context must be current, frames are only read by swaps made while it is current.
+    /// </summary>
+    bool Context::StartFrameCapture(Window* window, FrameCaptureCallback callback, int32_t latency)
+    {
+        if (window->m_Context->m_API == ContextAPI::None
+            || window->m_Context->m_API == ContextAPI::Software)
+        {
+            CPP_GLFW_ERROR("Cannot capture frames of a window that has no OpenGL or OpenGL ES context!");
+            return false;
+        }
+
+        if (GetCurrentContext() != window)
+        {
+            CPP_GLFW_ERROR("Cannot start frame capture on a window whose context is not current!");
+            return false;
+        }
+
+        if (!callback)
+        {
+            CPP_GLFW_ERROR("Frame capture callback cannot be null!");
+            return false;
+        }
+
+        StopFrameCapture(window);
+
+        window->m_Context->m_Capture = FrameCapture::Create(window, callback, latency);
+        return window->m_Context->m_Capture != nullptr;
+    }
+
+    /// <summary> Delivers the frames still in flight before returning, the window's context must be current </summary>
+    void Context::StopFrameCapture(Window* window)
+    {
+        if (!window->m_Context->m_Capture)
+        {
+            return;
+        }
+
+        if (GetCurrentContext() != window)
+        {
+            CPP_GLFW_ERROR("Cannot stop frame capture on a window whose context is not current!");
+            return;
+        }
+
+        window->m_Context->m_Capture->Finish(window);
+
+        delete window->m_Context->m_Capture;
+        window->m_Context->m_Capture = nullptr;
+    }
 }
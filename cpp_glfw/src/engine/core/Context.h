@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/core/Base.h"
+#include "engine/core/FrameCapture.h"
 
 namespace cpp_glfw
 {
@@ -8,8 +9,23 @@ namespace cpp_glfw
     struct FramebufferConfig;
     struct ContextConfig;
 
+    /// <summary>
+    /// Pixel buffer of a window created with ContextAPI::Software, 32 bit BGRX rows starting from the top.
+    /// The buffer is the one that will be presented by the next SwapBuffers, so it changes after every swap.
+    /// </summary>
+    struct SoftwareFramebuffer
+    {
+        uint8_t* pixels;
+        int32_t width;
+        int32_t height;
+        int32_t stride; //in bytes, a multiple of 64 so every row starts on a cache line
+        int32_t age; //number of swaps since these pixels were presented, 0 if the contents are undefined
+    };
+
     class Context
     {
+        CPP_GLFW_MEMORY_TAG(MemoryTag::Context)
+
     public:
         ContextAPI m_API;
         ContextType m_Type;
@@ -28,6 +44,8 @@ namespace cpp_glfw
         PFNGLGETINTEGERVPROC GetIntegerv;
         PFNGLGETSTRINGPROC GetString;
 
+        FrameCapture* m_Capture; //set while frames are captured on swap
+
     public: CPP_GLFW_PUBLIC_API
         static Window* GetCurrentContext();
         static bool StringInExtensionString(const char* string, const char* extensions);
@@ -41,6 +59,12 @@ namespace cpp_glfw
         static GLProc GetGLProcAddress(const char* procedureName);
         static void DestroyContext(Window* window);
 
+        static bool GetSoftwareFramebuffer(Window* window, SoftwareFramebuffer* framebuffer);
+        static void AddDamageRect(Window* window, int32_t x, int32_t y, int32_t width, int32_t height);
+
+        static bool StartFrameCapture(Window* window, FrameCaptureCallback callback, int32_t latency);
+        static void StopFrameCapture(Window* window);
+
     protected: CPP_GLFW_PLATFORM_API
         static void PlatformMakeContextCurrent(Window* window);
         static void PlatformSwapBuffers(Window* window);
@@ -48,5 +72,10 @@ namespace cpp_glfw
         static bool PlatformExtensionSupported(const char* extension);
         static GLProc PlatformGetGLProcAddress(const char* procedureName);
         static void PlatformDestroyContext(Window* window);
+
+        static bool PlatformGetSoftwareFramebuffer(Window* window, SoftwareFramebuffer* framebuffer);
+        static void PlatformAddDamageRect(Window* window, int32_t x, int32_t y, int32_t width, int32_t height);
+        static void PlatformSwapSoftwareBuffers(Window* window);
+        static void PlatformDestroySoftwareContext(Window* window);
     };
 }
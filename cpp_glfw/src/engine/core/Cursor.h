@@ -6,11 +6,25 @@ namespace cpp_glfw
 {
     class Cursor
     {
+        CPP_GLFW_MEMORY_TAG(MemoryTag::Cursor)
+
+    public: CPP_GLFW_INTERNAL_API
+        uint64_t m_Hash = 0; //content hash of custom cursors, used to find them in the cache
+        uint32_t m_Index = 0; //position in Platform::s_Cursors, so it can be removed without a search
+        uint32_t m_Id = 0;
+        uint32_t m_RefCount = 0;
+        uint32_t m_WindowCount = 0; //windows that currently have this cursor set
+        bool m_Standard = false;
+
     public:
         static Cursor* Create(const Image* image, int32_t xHot, int32_t yHot);
         static Cursor* Create(CursorShape shape);
+        static Cursor* Create(const std::vector<Image*>& images, const std::vector<double>& durations, int32_t xHot, int32_t yHot);
 
     public:
         virtual ~Cursor() = default;
+
+    public: CPP_GLFW_PUBLIC_API
+        uint32_t GetId() const { return m_Id; }
     };
 }
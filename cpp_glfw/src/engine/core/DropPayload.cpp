@@ -0,0 +1,108 @@
+#include "engine/core/Platform.h"
+
+namespace cpp_glfw
+{
+    /////////////////////////////////////// PUBLIC API ////////////////////////////////////////
+
+    uint32_t DropPayload::GetCount() const
+    {
+        return (uint32_t)m_Offsets.size();
+    }
+
+    const char* DropPayload::GetPath(uint32_t index) const
+    {
+        if (index >= m_Offsets.size())
+        {
+            CPP_GLFW_ERROR("Invalid drop path index %u", index);
+            return nullptr;
+        }
+
+        return &m_Arena[m_Offsets[index]];
+    }
+
+    uint32_t DropPayload::GetPathLength(uint32_t index) const
+    {
+        if (index >= m_Lengths.size())
+        {
+            CPP_GLFW_ERROR("Invalid drop path index %u", index);
+            return 0;
+        }
+
+        return m_Lengths[index];
+    }
+
+    /// <summary> Pointer table for code written against the old drop callback, valid until the next batch </summary>
+    const char** DropPayload::GetPaths() const
+    {
+        if (!m_PathsValid)
+        {
+            m_Paths.resize(m_Offsets.size());
+            for (size_t i = 0; i < m_Offsets.size(); i++)
+            {
+                m_Paths[i] = &m_Arena[m_Offsets[i]];
+            }
+            m_PathsValid = true;
+        }
+
+        return m_Paths.data();
+    }
+
+    uint32_t DropPayload::GetFirstIndex() const
+    {
+        return m_FirstIndex;
+    }
+
+    uint32_t DropPayload::GetTotalCount() const
+    {
+        return m_TotalCount;
+    }
+
+    bool DropPayload::IsLastBatch() const
+    {
+        return m_FirstIndex + GetCount() >= m_TotalCount;
+    }
+
+
+
+    ////////////////////////////////////// INTERNAL API ///////////////////////////////////////
+
+    /// <summary> Starts a new batch, clearing keeps the capacity so repeated drops do not allocate </summary>
+    void DropPayload::Begin(uint32_t firstIndex, uint32_t totalCount)
+    {
+        m_Arena.clear();
+        m_Offsets.clear();
+        m_Lengths.clear();
+        m_PathsValid = false;
+        m_FirstIndex = firstIndex;
+        m_TotalCount = totalCount;
+    }
+
+    /// <summary> Returns room for a path of up to maxLength bytes plus its terminator at the end of the arena </summary>
+    char* DropPayload::Reserve(uint32_t maxLength)
+    {
+        const size_t offset = m_Arena.size();
+
+        //grow geometrically, resize alone would only add what this path needs
+        if (offset + maxLength + 1 > m_Arena.capacity())
+        {
+            m_Arena.reserve(std::max(m_Arena.capacity() * 2, offset + maxLength + 1));
+        }
+
+        m_Arena.resize(offset + maxLength + 1);
+        return &m_Arena[offset];
+    }
+
+    /// <summary> Keeps the first length bytes of the last reservation as a path and gives the rest back </summary>
+    void DropPayload::Commit(uint32_t length)
+    {
+        //the reservation starts right after the last committed path
+        const size_t offset = m_Offsets.empty() ? 0 : (size_t)m_Offsets.back() + m_Lengths.back() + 1;
+
+        m_Arena.resize(offset + length + 1);
+        m_Arena[offset + length] = '\0';
+
+        m_Offsets.push_back((uint32_t)offset);
+        m_Lengths.push_back(length);
+        m_PathsValid = false;
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "engine/core/Base.h"
+
+namespace cpp_glfw
+{
+    /// <summary>
+    /// Paths of a drop, stored back to back as terminated utf-8 in one arena that keeps its capacity between drops.
+    /// Large drops can be delivered in batches, then the payload only holds the current batch
+    /// and GetFirstIndex tells where it starts in the whole drop.
+    /// </summary>
+    class DropPayload
+    {
+    protected:
+        TaggedVector<char, MemoryTag::Input> m_Arena;
+        TaggedVector<uint32_t, MemoryTag::Input> m_Offsets; //start of each path in the arena
+        TaggedVector<uint32_t, MemoryTag::Input> m_Lengths; //bytes without the terminator
+        mutable TaggedVector<const char*, MemoryTag::Input> m_Paths; //built on request, the arena may move while paths are added
+        mutable bool m_PathsValid = false;
+        uint32_t m_FirstIndex = 0;
+        uint32_t m_TotalCount = 0;
+
+    public: CPP_GLFW_PUBLIC_API
+        uint32_t GetCount() const;
+        const char* GetPath(uint32_t index) const;
+        uint32_t GetPathLength(uint32_t index) const;
+        const char** GetPaths() const;
+
+        uint32_t GetFirstIndex() const;
+        uint32_t GetTotalCount() const;
+        bool IsLastBatch() const;
+
+    public: CPP_GLFW_INTERNAL_API
+        void Begin(uint32_t firstIndex, uint32_t totalCount);
+        char* Reserve(uint32_t maxLength);
+        void Commit(uint32_t length);
+    };
+}
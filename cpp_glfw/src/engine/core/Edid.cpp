@@ -0,0 +1,326 @@
+#include "engine/core/Platform.h"
+
+namespace cpp_glfw
+{
+    ////////////////////////////////////// STATIC INIT ///////////////////////////////////////////
+
+    TaggedMap<uint64_t, Edid::CacheEntry, MemoryTag::Monitor> Edid::s_Cache = {};
+
+
+
+    ////////////////////////////////////// INTERNAL API ///////////////////////////////////////
+
+    /// <summary> Returns the cached result for this blob, parsing it on first use. The pointer stays valid until Terminate </summary>
+    const EdidInfo* Edid::Get(const uint8_t* data, size_t size)
+    {
+        uint64_t key = Utils::Hash(data, size);
+
+        //a hash hit with a different blob moves on to the next key
+        for (auto it = s_Cache.find(key); it != s_Cache.end(); it = s_Cache.find(++key))
+        {
+            const CacheEntry& entry = it->second;
+            if (entry.data.size() == size
+                && memcmp(entry.data.data(), data, size) == 0)
+            {
+                return &entry.info;
+            }
+        }
+
+        EdidInfo info;
+        if (!Parse(data, size, &info))
+        {
+            return nullptr;
+        }
+
+        CacheEntry& entry = s_Cache[key];
+        entry.data.assign(data, data + size);
+        entry.info = info;
+        return &entry.info;
+    }
+
+    bool Edid::Parse(const uint8_t* data, size_t size, EdidInfo* info)
+    {
+        static const uint8_t header[8] = { 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00 };
+
+        memset(info, 0, sizeof(EdidInfo));
+
+        if (size < 128
+            || memcmp(data, header, sizeof(header)) != 0)
+        {
+            return false;
+        }
+
+        uint8_t checksum = 0;
+        for (int32_t i = 0; i < 128; i++)
+        {
+            checksum += data[i];
+        }
+
+        if (checksum != 0)
+        {
+            CPP_GLFW_WARN("EDID base block checksum mismatch");
+            return false;
+        }
+
+        //manufacturer id is three 5 bit letters, big endian
+        const uint16_t manufacturer = (data[8] << 8) | data[9];
+        info->manufacturer[0] = (char)('A' - 1 + ((manufacturer >> 10) & 0x1f));
+        info->manufacturer[1] = (char)('A' - 1 + ((manufacturer >> 5) & 0x1f));
+        info->manufacturer[2] = (char)('A' - 1 + (manufacturer & 0x1f));
+
+        info->productCode = data[10] | (data[11] << 8);
+        info->serialNumber = data[12] | (data[13] << 8) | (data[14] << 16) | ((uint32_t)data[15] << 24);
+        info->version = data[18];
+        info->revision = data[19];
+        info->widthInMillimeters = data[21] * 10;
+        info->heightInMillimeters = data[22] * 10;
+
+        for (int32_t offset = 54; offset < 126; offset += 18)
+        {
+            ParseDescriptor(&data[offset], info);
+        }
+
+        const size_t extensionCount = std::min((size_t)data[126], size / 128 - 1);
+
+        for (size_t i = 1; i <= extensionCount; i++)
+        {
+            const uint8_t* block = &data[i * 128];
+
+            switch (block[0])
+            {
+                case 0x02: ParseCta(block, info); break;
+                case 0x70: ParseDisplayId(block, info); break;
+                default: break;
+            }
+        }
+
+        return true;
+    }
+
+    void Edid::Terminate()
+    {
+        TaggedMap<uint64_t, CacheEntry, MemoryTag::Monitor>().swap(s_Cache);
+    }
+
+
+
+    ///////////////////////////////////////// UTILS ///////////////////////////////////////////
+
+    void Edid::ParseDescriptor(const uint8_t* descriptor, EdidInfo* info)
+    {
+        //a non zero pixel clock marks a detailed timing, the first one is the preferred timing
+        if (descriptor[0] || descriptor[1])
+        {
+            if (!info->hasNativeTiming)
+            {
+                ParseDetailedTiming(descriptor, &info->nativeTiming);
+                info->hasNativeTiming = true;
+            }
+            return;
+        }
+
+        switch (descriptor[3])
+        {
+            case 0xff: ParseDescriptorText(descriptor, info->serial); break;
+            case 0xfc: ParseDescriptorText(descriptor, info->name); break;
+
+            case 0xfd:
+            {
+                //range limits, EDID 1.4 adds 255 to the max rate with bit 1 and to the min rate with bit 0, which needs bit 1
+                const int32_t maxOffset = (descriptor[4] & 0x2) ? 255 : 0;
+                const int32_t minOffset = ((descriptor[4] & 0x3) == 0x3) ? 255 : 0;
+
+                if (!info->variableRefreshRate)
+                {
+                    info->minRefreshRate = descriptor[5] + minOffset;
+                    info->maxRefreshRate = descriptor[6] + maxOffset;
+                }
+                break;
+            }
+
+            default: break;
+        }
+    }
+
+    void Edid::ParseDetailedTiming(const uint8_t* descriptor, EdidTiming* timing)
+    {
+        const int32_t pixelClock = (descriptor[0] | (descriptor[1] << 8)) * 10;
+        const int32_t horizontalActive = descriptor[2] | ((descriptor[4] & 0xf0) << 4);
+        const int32_t horizontalBlank = descriptor[3] | ((descriptor[4] & 0x0f) << 8);
+        const int32_t verticalActive = descriptor[5] | ((descriptor[7] & 0xf0) << 4);
+        const int32_t verticalBlank = descriptor[6] | ((descriptor[7] & 0x0f) << 8);
+        const int32_t total = (horizontalActive + horizontalBlank) * (verticalActive + verticalBlank);
+
+        timing->width = horizontalActive;
+        timing->height = verticalActive;
+        timing->pixelClock = pixelClock;
+        timing->refreshRate = total ? pixelClock * 1000.0f / total : 0.0f;
+        timing->interlaced = (descriptor[17] & 0x80) != 0;
+    }
+
+    /// <summary> Descriptor text is up to 13 characters, terminated by a line feed and padded with spaces </summary>
+    void Edid::ParseDescriptorText(const uint8_t* descriptor, char* text)
+    {
+        int32_t length = 0;
+        for (; length < 13; length++)
+        {
+            const uint8_t c = descriptor[5 + length];
+            if (c == 0x0a)
+            {
+                break;
+            }
+            text[length] = (c >= 0x20 && c < 0x7f) ? (char)c : '?';
+        }
+
+        while (length > 0 && text[length - 1] == ' ')
+        {
+            length--;
+        }
+        text[length] = '\0';
+    }
+
+    void Edid::ParseCta(const uint8_t* block, EdidInfo* info)
+    {
+        const uint8_t timingOffset = block[2];
+
+        //data block collection, only present from revision 3
+        if (block[1] >= 3 && timingOffset >= 4 && timingOffset <= 127)
+        {
+            for (int32_t offset = 4; offset < timingOffset; )
+            {
+                const uint8_t tag = block[offset] >> 5;
+                const uint8_t length = block[offset] & 0x1f;
+                const uint8_t* payload = &block[offset + 1];
+
+                if (offset + 1 + length > timingOffset)
+                {
+                    break;
+                }
+
+                //extended tag 6 is the HDR static metadata block
+                if (tag == 7 && length >= 3 && payload[0] == 0x06)
+                {
+                    EdidHdrMetadata& hdr = info->hdr;
+                    hdr.present = true;
+                    hdr.traditionalSdr = (payload[1] & 0x1) != 0;
+                    hdr.traditionalHdr = (payload[1] & 0x2) != 0;
+                    hdr.pq = (payload[1] & 0x4) != 0;
+                    hdr.hlg = (payload[1] & 0x8) != 0;
+
+                    //luminance code values, see CTA-861.3
+                    if (length >= 4) hdr.maxLuminance = 50.0f * powf(2.0f, payload[3] / 32.0f);
+                    if (length >= 5) hdr.maxFrameAverageLuminance = 50.0f * powf(2.0f, payload[4] / 32.0f);
+                    if (length >= 6) hdr.minLuminance = hdr.maxLuminance * (payload[5] / 255.0f) * (payload[5] / 255.0f) / 100.0f;
+                }
+
+                offset += 1 + length;
+            }
+        }
+
+        //the detailed timings that follow are only used when the base block has none
+        if (timingOffset >= 4 && !info->hasNativeTiming)
+        {
+            for (int32_t offset = timingOffset; offset + 18 <= 127; offset += 18)
+            {
+                if (block[offset] || block[offset + 1])
+                {
+                    ParseDetailedTiming(&block[offset], &info->nativeTiming);
+                    info->hasNativeTiming = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    void Edid::ParseDisplayId(const uint8_t* block, EdidInfo* info)
+    {
+        //the section starts after the extension tag
+        const uint8_t* section = &block[1];
+        const int32_t sectionLength = std::min((int32_t)section[1], 121);
+        const bool version2 = section[0] >= 0x20;
+
+        for (int32_t offset = 4; offset + 3 <= 4 + sectionLength; )
+        {
+            const uint8_t tag = section[offset];
+            const uint8_t revision = section[offset + 1];
+            const uint8_t length = section[offset + 2];
+            const uint8_t* payload = &section[offset + 3];
+
+            if (offset + 3 + length > 4 + sectionLength)
+            {
+                break;
+            }
+
+            switch (tag)
+            {
+                //type I (1.x) and type VII (2.x) detailed timings, 20 bytes each
+                case 0x03:
+                case 0x22:
+                {
+                    for (int32_t i = 0; i + 20 <= length; i += 20)
+                    {
+                        const uint8_t* timing = &payload[i];
+                        const bool preferred = (timing[3] & 0x80) != 0;
+
+                        if (info->hasNativeTiming && !preferred)
+                        {
+                            continue;
+                        }
+
+                        //type VII counts the pixel clock in kHz, type I in units of 10 kHz
+                        const int32_t pixelClock = ((timing[0] | (timing[1] << 8) | (timing[2] << 16)) + 1) * (tag == 0x22 ? 1 : 10);
+                        const int32_t horizontalActive = (timing[4] | (timing[5] << 8)) + 1;
+                        const int32_t horizontalBlank = (timing[6] | (timing[7] << 8)) + 1;
+                        const int32_t verticalActive = (timing[12] | (timing[13] << 8)) + 1;
+                        const int32_t verticalBlank = (timing[14] | (timing[15] << 8)) + 1;
+                        const int64_t total = (int64_t)(horizontalActive + horizontalBlank) * (verticalActive + verticalBlank);
+
+                        //a preferred DisplayID timing replaces the base block one, which is often a compatibility mode
+                        info->nativeTiming.width = horizontalActive;
+                        info->nativeTiming.height = verticalActive;
+                        info->nativeTiming.pixelClock = pixelClock;
+                        info->nativeTiming.refreshRate = (float)(pixelClock * 1000.0 / total);
+                        info->nativeTiming.interlaced = (timing[3] & 0x10) != 0;
+                        info->hasNativeTiming = true;
+
+                        if (preferred)
+                        {
+                            break;
+                        }
+                    }
+                    break;
+                }
+
+                //dynamic video timing range limits (1.x)
+                case 0x09:
+                {
+                    if (!version2 && length >= 15)
+                    {
+                        info->minRefreshRate = payload[10];
+                        info->maxRefreshRate = payload[11];
+                        info->variableRefreshRate = (payload[14] & 0x80) != 0;
+                    }
+                    break;
+                }
+
+                //adaptive sync (2.x), descriptors are 6 bytes plus the extra size in the revision
+                case 0x2b:
+                {
+                    const int32_t descriptorSize = 6 + ((revision >> 4) & 0x7);
+
+                    if (length >= descriptorSize)
+                    {
+                        info->minRefreshRate = payload[2];
+                        info->maxRefreshRate = (payload[3] | ((payload[4] & 0x3) << 8)) + 1;
+                        info->variableRefreshRate = true;
+                    }
+                    break;
+                }
+
+                default: break;
+            }
+
+            offset += 3 + length;
+        }
+    }
+}
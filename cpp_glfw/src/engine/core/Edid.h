@@ -0,0 +1,80 @@
+#pragma once
+
+#include "engine/core/Base.h"
+
+namespace cpp_glfw
+{
+    struct EdidTiming
+    {
+        int32_t width;
+        int32_t height;
+        int32_t pixelClock; //in kHz
+        float refreshRate;
+        bool interlaced;
+    };
+
+    struct EdidHdrMetadata
+    {
+        bool present;
+        bool traditionalSdr;
+        bool traditionalHdr;
+        bool pq; //SMPTE ST 2084
+        bool hlg;
+        float maxLuminance; //desired content max luminance in cd/m2, 0 if not specified
+        float maxFrameAverageLuminance;
+        float minLuminance;
+    };
+
+    struct EdidInfo
+    {
+        char manufacturer[4]; //three letter PNP id
+        uint16_t productCode;
+        uint32_t serialNumber;
+        char serial[14]; //serial string descriptor, empty if not present
+        char name[14]; //display product name descriptor, empty if not present
+        uint8_t version;
+        uint8_t revision;
+        int32_t widthInMillimeters;
+        int32_t heightInMillimeters;
+
+        bool hasNativeTiming;
+        EdidTiming nativeTiming; //first detailed timing, the preferred one
+
+        int32_t minRefreshRate; //vertical range, 0 if not specified
+        int32_t maxRefreshRate;
+        bool variableRefreshRate; //the range comes from an adaptive sync or dynamic timing block
+
+        EdidHdrMetadata hdr;
+    };
+
+    /// <summary>
+    /// Parses the EDID base block and its CTA-861 and DisplayID extensions.
+    /// Parsed results are cached by a hash of the raw blob, so monitors that are enumerated again reuse them.
+    /// The cache keeps a copy of every blob and compares it on a hash hit, a different blob with the same hash gets the next free key.
+    /// Parse does not touch the cache and works on any EDID blob, such as one read from a fixture file.
+    /// </summary>
+    class Edid
+    {
+    protected:
+        struct CacheEntry
+        {
+            TaggedVector<uint8_t, MemoryTag::Monitor> data;
+            EdidInfo info;
+        };
+
+    protected:
+        static TaggedMap<uint64_t, CacheEntry, MemoryTag::Monitor> s_Cache;
+
+    public: CPP_GLFW_INTERNAL_API
+        static const EdidInfo* Get(const uint8_t* data, size_t size);
+        static bool Parse(const uint8_t* data, size_t size, EdidInfo* info);
+        static void Terminate();
+
+    protected: CPP_GLFW_UTILS
+        static void ParseDescriptor(const uint8_t* descriptor, EdidInfo* info);
+        static void ParseDetailedTiming(const uint8_t* descriptor, EdidTiming* timing);
+        static void ParseDescriptorText(const uint8_t* descriptor, char* text);
+        static void ParseCta(const uint8_t* block, EdidInfo* info);
+        static void ParseDisplayId(const uint8_t* block, EdidInfo* info);
+    };
+}
@@ -109,7 +109,7 @@ namespace cpp_glfw
             s_EGL.display = s_EGL.getDisplay(Platform::GetEglNativeDisplay());
         }
 
-        free(attribs);
+        Memory::Free(attribs);
 
         if (s_EGL.display == EGL_NO_DISPLAY)
         {
@@ -382,6 +382,18 @@ namespace cpp_glfw
         }
 
         EglContext* eglContext = new EglContext();
+        if (!eglContext)
+        {
+            if (client)
+            {
+                Platform::CloseLibrary(client);
+            }
+
+            s_EGL.destroySurface(s_EGL.display, surface);
+            s_EGL.destroyContext(s_EGL.display, contextHandle);
+            return false;
+        }
+
         eglContext->m_Handle = contextHandle;
         eglContext->m_Config = config;
         eglContext->m_Surface = surface;
@@ -0,0 +1,255 @@
+#include "engine/core/Platform.h"
+
+namespace cpp_glfw
+{
+    ////////////////////////////////////// INTERNAL API ///////////////////////////////////////
+
+    /// <summary> The window's context must be current, the buffers are created on it </summary>
+    FrameCapture* FrameCapture::Create(Window* window, FrameCaptureCallback callback, int32_t latency)
+    {
+        if (latency < 1
+            || latency > MaxLatency)
+        {
+            CPP_GLFW_ERROR("Invalid frame capture latency %i, must be between 1 and %i!", latency, MaxLatency);
+            return nullptr;
+        }
+
+        const Context* context = window->GetContext();
+        const bool es = context->m_API == ContextAPI::OpenGLES;
+
+        //entry points are only loaded when the version provides them, WGL may return garbage for missing ones
+        const bool hasPixelBuffers = es ? context->m_Major >= 3 : (context->m_Major > 2 || (context->m_Major == 2 && context->m_Minor >= 1));
+        const bool hasMapRange = context->m_Major >= 3;
+        const bool hasFences = es ? context->m_Major >= 3 : (context->m_Major > 3 || (context->m_Major == 3 && context->m_Minor >= 2));
+
+        FrameCapture* capture = new FrameCapture();
+        if (!capture)
+        {
+            return nullptr;
+        }
+
+        capture->m_Callback = callback;
+        capture->m_Latency = latency;
+
+        GLFunctions& gl = capture->m_GL;
+        gl.GetIntegerv = context->GetIntegerv;
+        gl.ReadPixels = (PFNGLREADPIXELSPROC)Context::GetGLProcAddress("glReadPixels");
+
+        if (context->m_Major >= 3)
+        {
+            gl.BindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)Context::GetGLProcAddress("glBindFramebuffer");
+        }
+
+        if (hasPixelBuffers)
+        {
+            gl.GenBuffers = (PFNGLGENBUFFERSPROC)Context::GetGLProcAddress("glGenBuffers");
+            gl.DeleteBuffers = (PFNGLDELETEBUFFERSPROC)Context::GetGLProcAddress("glDeleteBuffers");
+            gl.BindBuffer = (PFNGLBINDBUFFERPROC)Context::GetGLProcAddress("glBindBuffer");
+            gl.BufferData = (PFNGLBUFFERDATAPROC)Context::GetGLProcAddress("glBufferData");
+            gl.UnmapBuffer = (PFNGLUNMAPBUFFERPROC)Context::GetGLProcAddress("glUnmapBuffer");
+
+            if (hasMapRange)
+            {
+                gl.MapBufferRange = (PFNGLMAPBUFFERRANGEPROC)Context::GetGLProcAddress("glMapBufferRange");
+            }
+            else
+            {
+                gl.MapBuffer = (PFNGLMAPBUFFERPROC)Context::GetGLProcAddress("glMapBuffer");
+            }
+        }
+
+        if (hasPixelBuffers
+            && hasFences)
+        {
+            gl.FenceSync = (PFNGLFENCESYNCPROC)Context::GetGLProcAddress("glFenceSync");
+            gl.ClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)Context::GetGLProcAddress("glClientWaitSync");
+            gl.DeleteSync = (PFNGLDELETESYNCPROC)Context::GetGLProcAddress("glDeleteSync");
+
+            if (!gl.FenceSync
+                || !gl.ClientWaitSync
+                || !gl.DeleteSync)
+            {
+                gl.FenceSync = nullptr;
+            }
+        }
+
+        if (!gl.GetIntegerv
+            || !gl.ReadPixels)
+        {
+            CPP_GLFW_ERROR("Frame capture requires glReadPixels!");
+            delete capture;
+            return nullptr;
+        }
+
+        capture->m_Asynchronous = gl.GenBuffers
+            && gl.DeleteBuffers
+            && gl.BindBuffer
+            && gl.BufferData
+            && gl.UnmapBuffer
+            && (gl.MapBufferRange || gl.MapBuffer);
+
+        if (capture->m_Asynchronous)
+        {
+            for (int32_t i = 0; i < latency; i++)
+            {
+                gl.GenBuffers(1, &capture->m_Slots[i].buffer);
+            }
+        }
+        else
+        {
+            CPP_GLFW_WARN("Pixel buffer objects are not available, frames are captured synchronously");
+        }
+
+        return capture;
+    }
+
+    /// <summary> Called by SwapBuffers while the back buffer still holds the finished frame </summary>
+    void FrameCapture::Capture(Window* window)
+    {
+        int32_t width, height;
+        window->GetFramebufferSize(&width, &height);
+
+        const uint64_t index = m_FrameIndex++;
+
+        //nothing to read while minimized
+        if (width <= 0
+            || height <= 0)
+        {
+            return;
+        }
+
+        GLint readFramebuffer = 0;
+        if (m_GL.BindFramebuffer)
+        {
+            m_GL.GetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer);
+            m_GL.BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        }
+
+        if (!m_Asynchronous)
+        {
+            m_Pixels.resize((size_t)width * height * 4);
+            ReadFramebuffer(width, height, m_Pixels.data());
+
+            const CapturedFrame frame = { m_Pixels.data(), width, height, width * 4, index };
+            m_Callback(window, &frame);
+        }
+        else
+        {
+            GLint packBuffer = 0;
+            m_GL.GetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &packBuffer);
+
+            //deliver the reads that already completed, then make room if the ring is still full
+            while (m_PendingCount > 0
+                && (IsReady(m_Slots[m_Oldest]) || m_PendingCount == m_Latency))
+            {
+                Resolve(window, m_Slots[m_Oldest]);
+                m_Oldest = (m_Oldest + 1) % m_Latency;
+                m_PendingCount--;
+            }
+
+            Slot& slot = m_Slots[(m_Oldest + m_PendingCount) % m_Latency];
+            const GLsizeiptr size = (GLsizeiptr)width * height * 4;
+
+            m_GL.BindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+            if (slot.capacity < size)
+            {
+                m_GL.BufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+                slot.capacity = size;
+            }
+
+            //with a pack buffer bound the pointer is an offset into it
+            ReadFramebuffer(width, height, nullptr);
+
+            slot.fence = m_GL.FenceSync ? m_GL.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) : nullptr;
+            slot.width = width;
+            slot.height = height;
+            slot.index = index;
+            m_PendingCount++;
+
+            m_GL.BindBuffer(GL_PIXEL_PACK_BUFFER, packBuffer);
+        }
+
+        if (m_GL.BindFramebuffer)
+        {
+            m_GL.BindFramebuffer(GL_READ_FRAMEBUFFER, readFramebuffer);
+        }
+    }
+
+    /// <summary> Delivers the pending frames and releases the buffers, the window's context must be current </summary>
+    void FrameCapture::Finish(Window* window)
+    {
+        if (!m_Asynchronous)
+        {
+            return;
+        }
+
+        GLint packBuffer = 0;
+        m_GL.GetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &packBuffer);
+
+        for (; m_PendingCount > 0; m_PendingCount--)
+        {
+            Resolve(window, m_Slots[m_Oldest]);
+            m_Oldest = (m_Oldest + 1) % m_Latency;
+        }
+
+        m_GL.BindBuffer(GL_PIXEL_PACK_BUFFER, packBuffer);
+
+        for (int32_t i = 0; i < m_Latency; i++)
+        {
+            m_GL.DeleteBuffers(1, &m_Slots[i].buffer);
+            m_Slots[i] = {};
+        }
+    }
+
+
+
+    ///////////////////////////////////////// UTILS ///////////////////////////////////////////
+
+    void FrameCapture::ReadFramebuffer(int32_t width, int32_t height, void* pixels)
+    {
+        //RGBA rows are always a multiple of the default pack alignment of 4
+        m_GL.ReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    }
+
+    /// <summary> Without fences there is no way to ask, so the read is resolved once the ring wraps around to it </summary>
+    bool FrameCapture::IsReady(const Slot& slot)
+    {
+        if (!slot.fence)
+        {
+            return false;
+        }
+
+        const GLenum result = m_GL.ClientWaitSync(slot.fence, 0, 0);
+        return result == GL_ALREADY_SIGNALED
+            || result == GL_CONDITION_SATISFIED;
+    }
+
+    void FrameCapture::Resolve(Window* window, Slot& slot)
+    {
+        if (slot.fence)
+        {
+            m_GL.DeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+
+        const GLsizeiptr size = (GLsizeiptr)slot.width * slot.height * 4;
+
+        m_GL.BindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+
+        //mapping waits for the read if it did not finish yet
+        const void* pixels = m_GL.MapBufferRange
+            ? m_GL.MapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT)
+            : m_GL.MapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+
+        if (!pixels)
+        {
+            CPP_GLFW_ERROR("Failed to map frame capture buffer, frame %llu is lost!", (unsigned long long)slot.index);
+            return;
+        }
+
+        const CapturedFrame frame = { (const uint8_t*)pixels, slot.width, slot.height, slot.width * 4, slot.index };
+        m_Callback(window, &frame);
+
+        m_GL.UnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+}
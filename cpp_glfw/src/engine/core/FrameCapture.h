@@ -0,0 +1,84 @@
+#pragma once
+
+#include "engine/core/Base.h"
+
+namespace cpp_glfw
+{
+    class Window;
+
+    struct CapturedFrame
+    {
+        const uint8_t* pixels; //RGBA, rows from the bottom up as OpenGL reads them
+        int32_t width;
+        int32_t height;
+        int32_t stride; //in bytes
+        uint64_t index; //number of swaps since the capture started, frames may be skipped while minimized
+    };
+
+    typedef void(*FrameCaptureCallback)(Window*, const CapturedFrame*); //the pixels are only valid during the call
+
+    /// <summary>
+    /// Reads back the default framebuffer of a window right before its buffers are swapped.
+    /// With pixel buffer objects the read is queued into a ring of buffers and mapped up to latency swaps later,
+    /// earlier if its fence already signaled, so the render loop does not wait on the GPU.
+    /// Contexts without pixel buffer objects (OpenGL before 2.1, OpenGL ES 2) read synchronously and deliver right away.
+    /// All calls happen on the thread the context is current on.
+    /// </summary>
+    class FrameCapture
+    {
+        CPP_GLFW_MEMORY_TAG(MemoryTag::Capture)
+
+    public:
+        static constexpr int32_t MaxLatency = 8;
+
+    protected:
+        struct Slot
+        {
+            GLuint buffer;
+            GLsizeiptr capacity;
+            GLsync fence;
+            int32_t width;
+            int32_t height;
+            uint64_t index;
+        };
+
+        struct GLFunctions
+        {
+            PFNGLGETINTEGERVPROC GetIntegerv;
+            PFNGLREADPIXELSPROC ReadPixels;
+            PFNGLGENBUFFERSPROC GenBuffers;
+            PFNGLDELETEBUFFERSPROC DeleteBuffers;
+            PFNGLBINDBUFFERPROC BindBuffer;
+            PFNGLBUFFERDATAPROC BufferData;
+            PFNGLMAPBUFFERPROC MapBuffer;
+            PFNGLMAPBUFFERRANGEPROC MapBufferRange;
+            PFNGLUNMAPBUFFERPROC UnmapBuffer;
+            PFNGLBINDFRAMEBUFFERPROC BindFramebuffer;
+            PFNGLFENCESYNCPROC FenceSync;
+            PFNGLCLIENTWAITSYNCPROC ClientWaitSync;
+            PFNGLDELETESYNCPROC DeleteSync;
+        };
+
+    protected:
+        FrameCaptureCallback m_Callback;
+        GLFunctions m_GL;
+        bool m_Asynchronous;
+        int32_t m_Latency;
+        Slot m_Slots[MaxLatency];
+        int32_t m_Oldest; //oldest slot with a pending read
+        int32_t m_PendingCount;
+        uint64_t m_FrameIndex;
+        TaggedVector<uint8_t, MemoryTag::Capture> m_Pixels; //read target of the synchronous path
+
+    public: CPP_GLFW_INTERNAL_API
+        static FrameCapture* Create(Window* window, FrameCaptureCallback callback, int32_t latency);
+
+        void Capture(Window* window);
+        void Finish(Window* window);
+
+    protected: CPP_GLFW_UTILS
+        void ReadFramebuffer(int32_t width, int32_t height, void* pixels);
+        bool IsReady(const Slot& slot);
+        void Resolve(Window* window, Slot& slot);
+    };
+}
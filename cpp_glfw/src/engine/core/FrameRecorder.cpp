@@ -0,0 +1,334 @@
+#include "engine/core/Platform.h"
+
+namespace cpp_glfw
+{
+    ////////////////////////////////////// STATIC API ///////////////////////////////////////////
+
+    RecorderConfig RecorderConfig::Default()
+    {
+        return { RecorderFormat::Y4M, RecorderOverflow::Drop, 4, 60, 1 };
+    }
+
+
+
+    ////////////////////////////////////// PUBLIC API ///////////////////////////////////////
+
+    FrameRecorder* FrameRecorder::Open(const std::string& path, const RecorderConfig& config)
+    {
+        if (config.queueLength < 1)
+        {
+            CPP_GLFW_ERROR("Recorder queue length must be at least 1!");
+            return nullptr;
+        }
+
+        if (config.format == RecorderFormat::Y4M
+            && (config.frameRateNumerator <= 0 || config.frameRateDenominator <= 0))
+        {
+            CPP_GLFW_ERROR("Invalid recorder frame rate %i:%i!", config.frameRateNumerator, config.frameRateDenominator);
+            return nullptr;
+        }
+
+        FrameRecorder* recorder = new FrameRecorder();
+        if (!recorder)
+        {
+            return nullptr;
+        }
+
+        recorder->m_Config = config;
+        recorder->m_Queue.resize(config.queueLength);
+
+        if (!Platform::PlatformCreateOutputFile(path, &recorder->m_File))
+        {
+            delete recorder;
+            return nullptr;
+        }
+
+        recorder->m_Thread = std::thread(&FrameRecorder::Run, recorder);
+        return recorder;
+    }
+
+    /// <summary> Returns false if the frame was not queued, because it was dropped or the recorder failed </summary>
+    bool FrameRecorder::Submit(const CapturedFrame* frame)
+    {
+        if (m_Failed.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        if (m_Width == 0)
+        {
+            m_Width = frame->width;
+            m_Height = frame->height;
+        }
+        else if (frame->width != m_Width
+            || frame->height != m_Height)
+        {
+            m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+
+            if (!m_SizeMismatchWarned)
+            {
+                m_SizeMismatchWarned = true;
+                CPP_GLFW_WARN("Recorded frames must keep the size of the first one, %i x %i frame dropped", frame->width, frame->height);
+            }
+            return false;
+        }
+
+        int32_t slot;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+
+            if (m_QueueCount == m_Config.queueLength)
+            {
+                if (m_Config.overflow == RecorderOverflow::Drop)
+                {
+                    m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                m_FrameWritten.wait(lock, [this] { return m_QueueCount < m_Config.queueLength; });
+            }
+
+            slot = (m_QueueHead + m_QueueCount) % m_Config.queueLength;
+        }
+
+        //the slot past the queued frames is only touched by the submitting thread, so it is filled without the lock
+        QueuedFrame& queued = m_Queue[slot];
+        const size_t rowSize = (size_t)frame->width * 4;
+        queued.pixels.resize(rowSize * frame->height);
+        queued.index = frame->index;
+
+        for (int32_t y = 0; y < frame->height; y++)
+        {
+            memcpy(&queued.pixels[rowSize * y], frame->pixels + (size_t)frame->stride * (frame->height - 1 - y), rowSize);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_QueueCount++;
+        }
+        m_FrameQueued.notify_one();
+        return true;
+    }
+
+    uint64_t FrameRecorder::GetWrittenFrameCount() const
+    {
+        return m_WrittenCount.load(std::memory_order_relaxed);
+    }
+
+    uint64_t FrameRecorder::GetDroppedFrameCount() const
+    {
+        return m_DroppedCount.load(std::memory_order_relaxed);
+    }
+
+    /// <summary> Writes the frames still queued before closing the file </summary>
+    FrameRecorder::~FrameRecorder()
+    {
+        if (m_Thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Stop = true;
+            }
+            m_FrameQueued.notify_one();
+            m_Thread.join();
+        }
+
+        if (m_File.handle)
+        {
+            Platform::PlatformCloseOutputFile(&m_File);
+        }
+    }
+
+
+
+    ///////////////////////////////////////// UTILS ///////////////////////////////////////////
+
+    void FrameRecorder::Run()
+    {
+        for (;;)
+        {
+            int32_t slot;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_FrameQueued.wait(lock, [this] { return m_QueueCount > 0 || m_Stop; });
+
+                if (m_QueueCount == 0)
+                {
+                    return;
+                }
+
+                slot = m_QueueHead;
+            }
+
+            //after a failure the queue is still drained so a blocked caller can go on
+            if (!m_Failed.load(std::memory_order_relaxed))
+            {
+                if (WriteFrame(m_Queue[slot]))
+                {
+                    m_WrittenCount.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                {
+                    m_Failed.store(true, std::memory_order_relaxed);
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_QueueHead = (m_QueueHead + 1) % m_Config.queueLength;
+                m_QueueCount--;
+            }
+            m_FrameWritten.notify_one();
+        }
+    }
+
+    /// <summary> Fills the output buffer that is not being written and queues it, the other one stays in flight until the next call </summary>
+    bool FrameRecorder::WriteFrame(QueuedFrame& frame)
+    {
+        TaggedVector<uint8_t, MemoryTag::Capture>& output = m_Output[m_OutputIndex];
+        m_OutputIndex ^= 1;
+
+        if (m_Config.format == RecorderFormat::RGBA)
+        {
+            //the frame is already in its final layout, so it trades buffers with the output instead of being copied
+            output.swap(frame.pixels);
+            return Platform::PlatformWriteOutputFile(&m_File, output.data(), output.size());
+        }
+
+        char header[128];
+        int32_t headerLength = 0;
+
+        if (!m_HeaderWritten)
+        {
+            //C420jpeg is the default chroma siting, centered between the luma samples like the 2x2 average below
+            headerLength = snprintf(header, sizeof(header), "YUV4MPEG2 W%i H%i F%i:%i Ip A1:1 C420jpeg XCOLORRANGE=LIMITED\n",
+                m_Width, m_Height, m_Config.frameRateNumerator, m_Config.frameRateDenominator);
+            m_HeaderWritten = true;
+        }
+
+        static const char frameHeader[] = "FRAME\n";
+        const size_t frameHeaderLength = sizeof(frameHeader) - 1;
+        const size_t lumaSize = (size_t)m_Width * m_Height;
+        const size_t chromaSize = (size_t)((m_Width + 1) / 2) * ((m_Height + 1) / 2);
+
+        output.resize(headerLength + frameHeaderLength + lumaSize + chromaSize * 2);
+
+        uint8_t* data = output.data();
+        memcpy(data, header, headerLength);
+        memcpy(data + headerLength, frameHeader, frameHeaderLength);
+
+        uint8_t* y = data + headerLength + frameHeaderLength;
+        ConvertToI420(frame.pixels.data(), m_Width, m_Height, y, y + lumaSize, y + lumaSize + chromaSize);
+
+        return Platform::PlatformWriteOutputFile(&m_File, output.data(), output.size());
+    }
+
+    void FrameRecorder::ConvertToI420(const uint8_t* pixels, int32_t width, int32_t height, uint8_t* y, uint8_t* u, uint8_t* v)
+    {
+        const size_t stride = (size_t)width * 4;
+        const int32_t chromaWidth = (width + 1) / 2;
+
+        for (int32_t row = 0; row < height; row += 2)
+        {
+            //an odd last row is paired with itself
+            const int32_t next = std::min(row + 1, height - 1);
+
+            ConvertRowPair(pixels + stride * row, pixels + stride * next, width,
+                y + (size_t)width * row, y + (size_t)width * next,
+                u + (size_t)chromaWidth * (row / 2), v + (size_t)chromaWidth * (row / 2));
+        }
+    }
+
+    /// <summary>
+    /// BT.601 limited range. Luma is (66r + 129g + 25b + 128) / 256 + 16 which wraps in signed 16 bit lanes
+    /// but not in unsigned ones, chroma is computed from the sum of each 2x2 block in 32 bit lanes.
+    /// </summary>
+    void FrameRecorder::ConvertRowPair(const uint8_t* row0, const uint8_t* row1, int32_t width, uint8_t* y0, uint8_t* y1, uint8_t* u, uint8_t* v)
+    {
+        const __m128i one = _mm_set1_epi16(1);
+        const __m128i uRedGreen = _mm_set_epi16(-74, -38, -74, -38, -74, -38, -74, -38);
+        const __m128i uBlue = _mm_set_epi16(512, 112, 512, 112, 512, 112, 512, 112);
+        const __m128i vRedGreen = _mm_set_epi16(-94, 112, -94, 112, -94, 112, -94, 112);
+        const __m128i vBlue = _mm_set_epi16(512, -18, 512, -18, 512, -18, 512, -18);
+        const __m128i chromaOffset = _mm_set1_epi32(128);
+
+        int32_t x = 0;
+        for (; x + 8 <= width; x += 8)
+        {
+            __m128i r0, g0, b0, r1, g1, b1;
+            SplitChannels(row0 + x * 4, &r0, &g0, &b0);
+            SplitChannels(row1 + x * 4, &r1, &g1, &b1);
+
+            _mm_storel_epi64((__m128i*)(y0 + x), Luma(r0, g0, b0));
+            _mm_storel_epi64((__m128i*)(y1 + x), Luma(r1, g1, b1));
+
+            //vertical neighbours are added in 16 bit, horizontal ones by madd into 32 bit
+            const __m128i r = _mm_madd_epi16(_mm_add_epi16(r0, r1), one);
+            const __m128i g = _mm_madd_epi16(_mm_add_epi16(g0, g1), one);
+            const __m128i b = _mm_madd_epi16(_mm_add_epi16(b0, b1), one);
+
+            //the sums fit 16 bit, interleave them so every madd lane is a coefficient pair
+            const __m128i redGreen = _mm_unpacklo_epi16(_mm_packs_epi32(r, r), _mm_packs_epi32(g, g));
+            const __m128i blueOne = _mm_unpacklo_epi16(_mm_packs_epi32(b, b), one);
+
+            __m128i cu = _mm_add_epi32(_mm_madd_epi16(redGreen, uRedGreen), _mm_madd_epi16(blueOne, uBlue));
+            __m128i cv = _mm_add_epi32(_mm_madd_epi16(redGreen, vRedGreen), _mm_madd_epi16(blueOne, vBlue));
+            cu = _mm_add_epi32(_mm_srai_epi32(cu, 10), chromaOffset);
+            cv = _mm_add_epi32(_mm_srai_epi32(cv, 10), chromaOffset);
+
+            cu = _mm_packs_epi32(cu, cu);
+            cv = _mm_packs_epi32(cv, cv);
+            cu = _mm_packus_epi16(cu, cu);
+            cv = _mm_packus_epi16(cv, cv);
+
+            const int32_t packedU = _mm_cvtsi128_si32(cu);
+            const int32_t packedV = _mm_cvtsi128_si32(cv);
+            memcpy(u + x / 2, &packedU, 4);
+            memcpy(v + x / 2, &packedV, 4);
+        }
+
+        for (; x < width; x += 2)
+        {
+            //an odd last column is paired with itself
+            const int32_t next = std::min(x + 1, width - 1);
+            int32_t sumR = 0, sumG = 0, sumB = 0;
+
+            for (const int32_t column : { x, next })
+            {
+                const uint8_t* p0 = row0 + column * 4;
+                const uint8_t* p1 = row1 + column * 4;
+
+                y0[column] = (uint8_t)(((66 * p0[0] + 129 * p0[1] + 25 * p0[2] + 128) >> 8) + 16);
+                y1[column] = (uint8_t)(((66 * p1[0] + 129 * p1[1] + 25 * p1[2] + 128) >> 8) + 16);
+
+                sumR += p0[0] + p1[0];
+                sumG += p0[1] + p1[1];
+                sumB += p0[2] + p1[2];
+            }
+
+            u[x / 2] = (uint8_t)(((-38 * sumR - 74 * sumG + 112 * sumB + 512) >> 10) + 128);
+            v[x / 2] = (uint8_t)(((112 * sumR - 94 * sumG - 18 * sumB + 512) >> 10) + 128);
+        }
+    }
+
+    /// <summary> Deinterleaves eight RGBA pixels into one 16 bit lane per pixel and channel </summary>
+    void FrameRecorder::SplitChannels(const uint8_t* pixels, __m128i* r, __m128i* g, __m128i* b)
+    {
+        const __m128i mask = _mm_set1_epi32(0xff);
+        const __m128i lo = _mm_loadu_si128((const __m128i*)pixels);
+        const __m128i hi = _mm_loadu_si128((const __m128i*)(pixels + 16));
+
+        *r = _mm_packs_epi32(_mm_and_si128(lo, mask), _mm_and_si128(hi, mask));
+        *g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(lo, 8), mask), _mm_and_si128(_mm_srli_epi32(hi, 8), mask));
+        *b = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(lo, 16), mask), _mm_and_si128(_mm_srli_epi32(hi, 16), mask));
+    }
+
+    /// <summary> Returns eight luma bytes in the low half </summary>
+    __m128i FrameRecorder::Luma(__m128i r, __m128i g, __m128i b)
+    {
+        __m128i y = _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(66)), _mm_mullo_epi16(g, _mm_set1_epi16(129)));
+        y = _mm_add_epi16(y, _mm_mullo_epi16(b, _mm_set1_epi16(25)));
+        y = _mm_add_epi16(_mm_srli_epi16(_mm_add_epi16(y, _mm_set1_epi16(128)), 8), _mm_set1_epi16(16));
+        return _mm_packus_epi16(y, y);
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "engine/core/Base.h"
+#include "engine/core/FrameCapture.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <emmintrin.h>
+
+namespace cpp_glfw
+{
+    enum class RecorderFormat
+    {
+        Y4M = 0, //YUV4MPEG2 with 4:2:0 BT.601 limited range frames
+        RGBA = 1 //raw RGBA frames without any header
+    };
+
+    enum class RecorderOverflow
+    {
+        Drop = 0, //the frame is dropped and counted
+        Block = 1 //the caller waits for the writer
+    };
+
+    struct RecorderConfig
+    {
+        RecorderFormat format;
+        RecorderOverflow overflow; //what Submit does when every queued frame is still waiting for the writer
+        int32_t queueLength; //frames buffered between the caller and the writer thread
+        int32_t frameRateNumerator; //only written to the Y4M header
+        int32_t frameRateDenominator;
+
+    public:
+        static RecorderConfig Default();
+    };
+
+    struct OutputFile
+    {
+        void* handle;
+        void* overlapped; //platform state of the asynchronous writes
+        uint64_t offset;
+        bool pending; //a write is in flight
+    };
+
+    /// <summary>
+    /// Streams captured frames to a file from a background thread.
+    /// Submit only copies the frame into a queue slot, flipping it to top down rows.
+    /// The writer converts it and queues the write, while the previous one is still in flight it fills the other of two output buffers.
+    /// All frames must have the size of the first one. Submit must always be called from the same thread.
+    /// </summary>
+    class FrameRecorder
+    {
+        CPP_GLFW_MEMORY_TAG(MemoryTag::Capture)
+
+    protected:
+        struct QueuedFrame
+        {
+            TaggedVector<uint8_t, MemoryTag::Capture> pixels;
+            uint64_t index;
+        };
+
+    protected:
+        RecorderConfig m_Config;
+        OutputFile m_File;
+        int32_t m_Width = 0; //set by the first submitted frame
+        int32_t m_Height = 0;
+        bool m_SizeMismatchWarned = false;
+
+        TaggedVector<QueuedFrame, MemoryTag::Capture> m_Queue;
+        int32_t m_QueueHead = 0; //oldest frame waiting for the writer
+        int32_t m_QueueCount = 0;
+
+        TaggedVector<uint8_t, MemoryTag::Capture> m_Output[2]; //owned by the writer thread
+        int32_t m_OutputIndex = 0;
+        bool m_HeaderWritten = false;
+
+        std::thread m_Thread;
+        std::mutex m_Mutex;
+        std::condition_variable m_FrameQueued;
+        std::condition_variable m_FrameWritten;
+        bool m_Stop = false;
+        std::atomic<bool> m_Failed = { false };
+        std::atomic<uint64_t> m_WrittenCount = { 0 };
+        std::atomic<uint64_t> m_DroppedCount = { 0 };
+
+    public: CPP_GLFW_PUBLIC_API
+        static FrameRecorder* Open(const std::string& path, const RecorderConfig& config);
+
+        bool Submit(const CapturedFrame* frame);
+        uint64_t GetWrittenFrameCount() const;
+        uint64_t GetDroppedFrameCount() const;
+
+    public:
+        ~FrameRecorder();
+
+    protected:
+        FrameRecorder() = default;
+
+    protected: CPP_GLFW_UTILS
+        void Run();
+        bool WriteFrame(QueuedFrame& frame);
+
+        static void ConvertToI420(const uint8_t* pixels, int32_t width, int32_t height, uint8_t* y, uint8_t* u, uint8_t* v);
+        static void ConvertRowPair(const uint8_t* row0, const uint8_t* row1, int32_t width, uint8_t* y0, uint8_t* y1, uint8_t* u, uint8_t* v);
+        static void SplitChannels(const uint8_t* pixels, __m128i* r, __m128i* g, __m128i* b);
+        static __m128i Luma(__m128i r, __m128i g, __m128i b);
+    };
+}
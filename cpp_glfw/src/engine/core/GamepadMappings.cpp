@@ -0,0 +1,404 @@
+#include "engine/core/Platform.h"
+
+namespace cpp_glfw
+{
+    ////////////////////////////////////// STATIC INIT ///////////////////////////////////////////
+
+    TaggedVector<GamepadMapping, MemoryTag::Input> GamepadMappings::s_Mappings = {};
+    TaggedVector<int32_t, MemoryTag::Input> GamepadMappings::s_Table = {};
+
+    //mappings for the devices exposed by the built-in backends, matching the GUIDs they generate
+    const char* GamepadMappings::s_DefaultMappings =
+        "78696e70757401000000000000000000,XInput Gamepad,platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,\n"
+        "78696e70757402000000000000000000,XInput Wheel,platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,\n"
+        "78696e70757403000000000000000000,XInput Arcade Stick,platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,\n"
+        "78696e70757404000000000000000000,XInput Flight Stick,platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,\n"
+        "78696e70757405000000000000000000,XInput Dance Pad,platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,\n"
+        "78696e70757406000000000000000000,XInput Guitar,platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,\n"
+        "78696e70757408000000000000000000,XInput Drum Kit,platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,\n";
+
+
+
+    ////////////////////////////////////// INTERNAL API ///////////////////////////////////////
+
+    bool GamepadMappings::Init()
+    {
+        if (!s_Mappings.empty())
+        {
+            return true;
+        }
+
+        return Update(s_DefaultMappings, strlen(s_DefaultMappings));
+    }
+
+    void GamepadMappings::Terminate()
+    {
+        s_Mappings.clear();
+        s_Mappings.shrink_to_fit();
+        s_Table.clear();
+        s_Table.shrink_to_fit();
+    }
+
+    /// <summary> Parses mappings from SDL_GameControllerDB text, replacing existing mappings with the same GUID </summary>
+    bool GamepadMappings::Update(const char* data, size_t size)
+    {
+        const char* c = data;
+        const char* end = data + size;
+
+        //a database line is around 250 bytes, reserve once instead of growing on every few lines
+        s_Mappings.reserve(s_Mappings.size() + size / 200 + 1);
+
+        while (c < end)
+        {
+            const char* lineEnd = (const char*)memchr(c, '\n', end - c);
+            if (!lineEnd)
+            {
+                lineEnd = end;
+            }
+
+            GamepadMapping mapping;
+            if (ParseMapping(c, lineEnd, &mapping))
+            {
+                Insert(mapping);
+            }
+
+            c = lineEnd < end ? lineEnd + 1 : end;
+        }
+
+        return true;
+    }
+
+    bool GamepadMappings::Load(const std::string& path)
+    {
+        MappedFile file;
+        if (!Platform::PlatformMapFile(path, &file))
+        {
+            CPP_GLFW_ERROR("Failed to open gamepad mapping file '%s'!", path.c_str());
+            return false;
+        }
+
+        const bool result = Update(file.data, file.size);
+        Platform::PlatformUnmapFile(&file);
+        return result;
+    }
+
+    const GamepadMapping* GamepadMappings::Find(const uint8_t guid[16])
+    {
+        if (s_Table.empty())
+        {
+            return nullptr;
+        }
+
+        const size_t mask = s_Table.size() - 1;
+        for (size_t slot = HashGUID(guid) & mask; s_Table[slot] != -1; slot = (slot + 1) & mask)
+        {
+            const GamepadMapping& mapping = s_Mappings[s_Table[slot]];
+            if (memcmp(mapping.guid, guid, 16) == 0)
+            {
+                return &mapping;
+            }
+        }
+
+        return nullptr;
+    }
+
+    bool GamepadMappings::ParseGUID(const char* text, size_t length, uint8_t guid[16])
+    {
+        if (length < 32)
+        {
+            return false;
+        }
+
+        for (int32_t i = 0; i < 32; i++)
+        {
+            const char h = text[i];
+            uint8_t value;
+
+            if (h >= '0' && h <= '9') value = h - '0';
+            else if (h >= 'a' && h <= 'f') value = h - 'a' + 10;
+            else if (h >= 'A' && h <= 'F') value = h - 'A' + 10;
+            else return false;
+
+            if (i & 1)
+            {
+                guid[i >> 1] |= value;
+            }
+            else
+            {
+                guid[i >> 1] = value << 4;
+            }
+        }
+
+        return true;
+    }
+
+
+
+    ///////////////////////////////////////// UTILS ///////////////////////////////////////////
+
+    bool GamepadMappings::ParseMapping(const char* c, const char* end, GamepadMapping* mapping)
+    {
+        if (end > c && end[-1] == '\r')
+        {
+            end--;
+        }
+
+        //skip comments and empty lines
+        if (c == end
+            || *c == '#')
+        {
+            return false;
+        }
+
+        memset(mapping, 0, sizeof(GamepadMapping));
+
+        if (!ParseGUID(c, end - c, mapping->guid)
+            || end - c < 33
+            || c[32] != ',')
+        {
+            return false;
+        }
+        c += 33;
+
+        const char* name = c;
+        while (c < end && *c != ',')
+        {
+            c++;
+        }
+
+        if (c == end)
+        {
+            return false;
+        }
+
+        memcpy(mapping->name, name, std::min((size_t)(c - name), sizeof(mapping->name) - 1));
+        c++;
+
+        const char* platformName = Platform::PlatformGetMappingName();
+        const size_t platformNameLength = strlen(platformName);
+
+        //fields are key:value pairs separated by commas, each byte is visited once
+        while (c < end)
+        {
+            const char* key = c;
+            while (c < end && *c != ':' && *c != ',')
+            {
+                c++;
+            }
+
+            if (c == end
+                || *c == ',')
+            {
+                c = c < end ? c + 1 : end;
+                continue;
+            }
+
+            const size_t keyLength = c - key;
+            const char* value = ++c;
+            while (c < end && *c != ',')
+            {
+                c++;
+            }
+
+            if (keyLength == 8
+                && memcmp(key, "platform", 8) == 0)
+            {
+                if ((size_t)(c - value) != platformNameLength
+                    || memcmp(value, platformName, platformNameLength) != 0)
+                {
+                    //mapping for another platform
+                    return false;
+                }
+            }
+            else
+            {
+                GamepadElement* element = FindElement(mapping, key, keyLength);
+                if (element)
+                {
+                    ParseElement(value, c, element);
+                }
+            }
+
+            c = c < end ? c + 1 : end;
+        }
+
+        return true;
+    }
+
+    /// <summary> Returns the mapping element for a database field name, nullptr for unknown fields </summary>
+    GamepadElement* GamepadMappings::FindElement(GamepadMapping* mapping, const char* key, size_t length)
+    {
+        struct Field
+        {
+            const char* name;
+            bool axis;
+            int32_t index;
+        };
+
+        //grouped by name length, so a lookup compares against at most four names
+        static const Field fields1[] = { { "a", false, (int32_t)GamepadButton::A }, { "b", false, (int32_t)GamepadButton::B }, { "x", false, (int32_t)GamepadButton::X }, { "y", false, (int32_t)GamepadButton::Y } };
+        static const Field fields4[] = { { "back", false, (int32_t)GamepadButton::Back }, { "dpup", false, (int32_t)GamepadButton::DPadUp } };
+        static const Field fields5[] = { { "leftx", true, (int32_t)GamepadAxis::LeftX }, { "lefty", true, (int32_t)GamepadAxis::LeftY }, { "start", false, (int32_t)GamepadButton::Start }, { "guide", false, (int32_t)GamepadButton::Guide } };
+        static const Field fields6[] = { { "rightx", true, (int32_t)GamepadAxis::RightX }, { "righty", true, (int32_t)GamepadAxis::RightY }, { "dpdown", false, (int32_t)GamepadButton::DPadDown }, { "dpleft", false, (int32_t)GamepadButton::DPadLeft } };
+        static const Field fields7[] = { { "dpright", false, (int32_t)GamepadButton::DPadRight } };
+        static const Field fields9[] = { { "leftstick", false, (int32_t)GamepadButton::LeftThumb } };
+        static const Field fields10[] = { { "rightstick", false, (int32_t)GamepadButton::RightThumb } };
+        static const Field fields11[] = { { "lefttrigger", true, (int32_t)GamepadAxis::LeftTrigger } };
+        static const Field fields12[] = { { "righttrigger", true, (int32_t)GamepadAxis::RightTrigger }, { "leftshoulder", false, (int32_t)GamepadButton::LeftBumper } };
+        static const Field fields13[] = { { "rightshoulder", false, (int32_t)GamepadButton::RightBumber } };
+
+        const Field* candidates = nullptr;
+        size_t count = 0;
+
+        switch (length)
+        {
+            case 1:  candidates = fields1;  count = sizeof(fields1) / sizeof(Field); break;
+            case 4:  candidates = fields4;  count = sizeof(fields4) / sizeof(Field); break;
+            case 5:  candidates = fields5;  count = sizeof(fields5) / sizeof(Field); break;
+            case 6:  candidates = fields6;  count = sizeof(fields6) / sizeof(Field); break;
+            case 7:  candidates = fields7;  count = sizeof(fields7) / sizeof(Field); break;
+            case 9:  candidates = fields9;  count = sizeof(fields9) / sizeof(Field); break;
+            case 10: candidates = fields10; count = sizeof(fields10) / sizeof(Field); break;
+            case 11: candidates = fields11; count = sizeof(fields11) / sizeof(Field); break;
+            case 12: candidates = fields12; count = sizeof(fields12) / sizeof(Field); break;
+            case 13: candidates = fields13; count = sizeof(fields13) / sizeof(Field); break;
+            default: return nullptr;
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (memcmp(candidates[i].name, key, length) == 0)
+            {
+                return candidates[i].axis
+                    ? &mapping->axes[candidates[i].index]
+                    : &mapping->buttons[candidates[i].index];
+            }
+        }
+
+        return nullptr;
+    }
+
+    bool GamepadMappings::ParseElement(const char* c, const char* end, GamepadElement* element)
+    {
+        int8_t minimum = -1;
+        int8_t maximum = 1;
+
+        if (c < end && *c == '+')
+        {
+            minimum = 0;
+            c++;
+        }
+        else if (c < end && *c == '-')
+        {
+            maximum = 0;
+            c++;
+        }
+
+        if (c >= end)
+        {
+            return false;
+        }
+
+        GamepadElementType type;
+        switch (*c++)
+        {
+            case 'a': type = GamepadElementType::Axis; break;
+            case 'b': type = GamepadElementType::Button; break;
+            case 'h': type = GamepadElementType::HatBit; break;
+            default: return false;
+        }
+
+        uint32_t index = 0;
+        while (c < end && *c >= '0' && *c <= '9')
+        {
+            index = index * 10 + (*c++ - '0');
+        }
+
+        if (type == GamepadElementType::HatBit)
+        {
+            if (c >= end || *c++ != '.')
+            {
+                return false;
+            }
+
+            uint32_t bit = 0;
+            while (c < end && *c >= '0' && *c <= '9')
+            {
+                bit = bit * 10 + (*c++ - '0');
+            }
+
+            index = (index << 4) | bit;
+        }
+
+        element->type = type;
+        element->index = (uint8_t)index;
+
+        if (type == GamepadElementType::Axis)
+        {
+            element->axisScale = 2 / (maximum - minimum);
+            element->axisOffset = -(maximum + minimum);
+
+            if (c < end && *c == '~')
+            {
+                element->axisScale = -element->axisScale;
+                element->axisOffset = -element->axisOffset;
+            }
+        }
+
+        return true;
+    }
+
+    void GamepadMappings::Insert(const GamepadMapping& mapping)
+    {
+        if ((s_Mappings.size() + 1) * 2 > s_Table.size())
+        {
+            Rehash(std::max((size_t)64, s_Table.size() * 2));
+        }
+
+        const size_t mask = s_Table.size() - 1;
+        size_t slot = HashGUID(mapping.guid) & mask;
+        for (; s_Table[slot] != -1; slot = (slot + 1) & mask)
+        {
+            GamepadMapping& existing = s_Mappings[s_Table[slot]];
+            if (memcmp(existing.guid, mapping.guid, 16) == 0)
+            {
+                //later mappings override earlier ones
+                existing = mapping;
+                return;
+            }
+        }
+
+        s_Table[slot] = (int32_t)s_Mappings.size();
+        s_Mappings.push_back(mapping);
+    }
+
+    void GamepadMappings::Rehash(size_t capacity)
+    {
+        s_Table.assign(capacity, -1);
+
+        const size_t mask = capacity - 1;
+        for (size_t i = 0; i < s_Mappings.size(); i++)
+        {
+            size_t slot = HashGUID(s_Mappings[i].guid) & mask;
+            while (s_Table[slot] != -1)
+            {
+                slot = (slot + 1) & mask;
+            }
+            s_Table[slot] = (int32_t)i;
+        }
+    }
+
+    size_t GamepadMappings::HashGUID(const uint8_t guid[16])
+    {
+        uint64_t low, high;
+        memcpy(&low, guid, 8);
+        memcpy(&high, guid + 8, 8);
+
+        //GUIDs share long runs of zeros and vendor bytes, so mix both halves thoroughly
+        uint64_t hash = low ^ (high * 0x9e3779b97f4a7c15ull);
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 33;
+        return (size_t)hash;
+    }
+}
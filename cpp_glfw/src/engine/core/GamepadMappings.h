@@ -0,0 +1,59 @@
+#pragma once
+
+#include "engine/core/Base.h"
+
+namespace cpp_glfw
+{
+    enum class GamepadElementType : uint8_t
+    {
+        None = 0,
+        Axis = 1,
+        Button = 2,
+        HatBit = 3
+    };
+
+    struct GamepadElement
+    {
+        GamepadElementType type;
+        uint8_t index; //axis or button index, (hat << 4) | bit for hat bits
+        int8_t axisScale;
+        int8_t axisOffset;
+    };
+
+    struct GamepadMapping
+    {
+        uint8_t guid[16];
+        char name[128];
+        GamepadElement buttons[(int32_t)GamepadButton::Count];
+        GamepadElement axes[(int32_t)GamepadAxis::Count];
+    };
+
+    /// <summary>
+    /// SDL_GameControllerDB compatible mapping database.
+    /// Mappings live in one flat array indexed by an open-addressing table keyed by the 128-bit GUID.
+    /// </summary>
+    class GamepadMappings
+    {
+    protected:
+        static TaggedVector<GamepadMapping, MemoryTag::Input> s_Mappings;
+        static TaggedVector<int32_t, MemoryTag::Input> s_Table; //indices into s_Mappings, -1 for empty slots, size is a power of two
+        static const char* s_DefaultMappings;
+
+    public: CPP_GLFW_INTERNAL_API
+        static bool Init();
+        static void Terminate();
+
+        static bool Update(const char* data, size_t size);
+        static bool Load(const std::string& path);
+        static const GamepadMapping* Find(const uint8_t guid[16]);
+        static bool ParseGUID(const char* text, size_t length, uint8_t guid[16]);
+
+    protected: CPP_GLFW_UTILS
+        static bool ParseMapping(const char* c, const char* end, GamepadMapping* mapping);
+        static bool ParseElement(const char* c, const char* end, GamepadElement* element);
+        static GamepadElement* FindElement(GamepadMapping* mapping, const char* key, size_t length);
+        static void Insert(const GamepadMapping& mapping);
+        static void Rehash(size_t capacity);
+        static size_t HashGUID(const uint8_t guid[16]);
+    };
+}
@@ -0,0 +1,174 @@
+#include "engine/core/Platform.h"
+
+namespace cpp_glfw
+{
+    ////////////////////////////////////// STATIC API ///////////////////////////////////////////
+
+    GammaSettings GammaSettings::FromGamma(float gamma)
+    {
+        const GammaChannel channel = { gamma, 0.0f, 1.0f };
+        return { channel, channel, channel };
+    }
+
+
+
+    ////////////////////////////////////// INTERNAL API ///////////////////////////////////////
+
+    bool Gamma::IsValid(const GammaSettings& settings)
+    {
+        for (const GammaChannel* channel : { &settings.red, &settings.green, &settings.blue })
+        {
+            if (channel->gamma != channel->gamma
+                || channel->gamma <= 0.0f
+                || channel->gamma > FLT_MAX
+                || channel->brightness != channel->brightness
+                || channel->contrast != channel->contrast
+                || channel->contrast < 0.0f)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void Gamma::GenerateRamp(const GammaSettings& settings, uint32_t size, MonitorGammaRamp* ramp)
+    {
+        ramp->Resize(size);
+
+        GenerateChannel(settings.red, size, ramp->red.data());
+        GenerateChannel(settings.green, size, ramp->green.data());
+        GenerateChannel(settings.blue, size, ramp->blue.data());
+    }
+
+    /// <summary> Writes from + (to - from) * t into ramp, which may alias either input </summary>
+    bool Gamma::LerpRamp(const MonitorGammaRamp& from, const MonitorGammaRamp& to, float t, MonitorGammaRamp* ramp)
+    {
+        if (from.size != to.size)
+        {
+            CPP_GLFW_ERROR("Cannot blend gamma ramps of different sizes!");
+            return false;
+        }
+
+        t = Utils::fminf(Utils::fmaxf(t, 0.0f), 1.0f);
+
+        ramp->Resize(from.size);
+
+        LerpChannel(from.red.data(), to.red.data(), t, from.size, ramp->red.data());
+        LerpChannel(from.green.data(), to.green.data(), t, from.size, ramp->green.data());
+        LerpChannel(from.blue.data(), to.blue.data(), t, from.size, ramp->blue.data());
+        return true;
+    }
+
+
+
+    ///////////////////////////////////////// UTILS ///////////////////////////////////////////
+
+    void Gamma::GenerateChannel(const GammaChannel& channel, uint32_t size, uint16_t* values)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 exponent = _mm_set1_ps(1.0f / channel.gamma);
+        const __m128 contrast = _mm_set1_ps(channel.contrast);
+        const __m128 offset = _mm_set1_ps(0.5f + channel.brightness);
+        const __m128 step = _mm_set1_ps(size > 1 ? 1.0f / (float)(size - 1) : 0.0f);
+
+        for (uint32_t i = 0; i < size; i += 4)
+        {
+            const __m128 x = _mm_mul_ps(_mm_set_ps((float)(i + 3), (float)(i + 2), (float)(i + 1), (float)i), step);
+
+            //pow(x, 1 / gamma), log2 of zero is not defined so those entries are masked to zero
+            __m128 value = _mm_and_ps(_mm_cmpgt_ps(x, zero), Exp2(_mm_mul_ps(Log2(x), exponent)));
+
+            value = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(value, half), contrast), offset);
+            value = _mm_min_ps(_mm_max_ps(value, zero), one);
+            value = _mm_add_ps(_mm_mul_ps(value, _mm_set1_ps(65535.0f)), half);
+
+            const __m128i packed = PackUnsigned16(value);
+
+            if (i + 4 <= size)
+            {
+                _mm_storel_epi64((__m128i*)&values[i], packed);
+            }
+            else
+            {
+                uint16_t tail[8];
+                _mm_storeu_si128((__m128i*)tail, packed);
+                memcpy(&values[i], tail, (size - i) * sizeof(uint16_t));
+            }
+        }
+    }
+
+    void Gamma::LerpChannel(const uint16_t* from, const uint16_t* to, float t, uint32_t size, uint16_t* values)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128 weight = _mm_set1_ps(t);
+        const __m128 half = _mm_set1_ps(0.5f);
+
+        uint32_t i = 0;
+        for (; i + 4 <= size; i += 4)
+        {
+            const __m128 a = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)&from[i]), zero));
+            const __m128 b = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)&to[i]), zero));
+            const __m128 value = _mm_add_ps(_mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), weight)), half);
+
+            _mm_storel_epi64((__m128i*)&values[i], PackUnsigned16(value));
+        }
+
+        for (; i < size; i++)
+        {
+            values[i] = (uint16_t)(from[i] + (to[i] - from[i]) * t + 0.5f);
+        }
+    }
+
+    /// <summary> log2 for positive inputs, the mantissa term uses the atanh series which converges fast on [1, 2) </summary>
+    __m128 Gamma::Log2(__m128 x)
+    {
+        const __m128i bits = _mm_castps_si128(x);
+        const __m128 exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+        const __m128 mantissa = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f800000)));
+
+        //log2(m) = 2 / ln(2) * atanh((m - 1) / (m + 1))
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 t = _mm_div_ps(_mm_sub_ps(mantissa, one), _mm_add_ps(mantissa, one));
+        const __m128 t2 = _mm_mul_ps(t, t);
+
+        __m128 series = _mm_set1_ps(1.0f / 11.0f);
+        series = _mm_add_ps(_mm_set1_ps(1.0f / 9.0f), _mm_mul_ps(series, t2));
+        series = _mm_add_ps(_mm_set1_ps(1.0f / 7.0f), _mm_mul_ps(series, t2));
+        series = _mm_add_ps(_mm_set1_ps(1.0f / 5.0f), _mm_mul_ps(series, t2));
+        series = _mm_add_ps(_mm_set1_ps(1.0f / 3.0f), _mm_mul_ps(series, t2));
+        series = _mm_add_ps(one, _mm_mul_ps(series, t2));
+
+        return _mm_add_ps(exponent, _mm_mul_ps(_mm_mul_ps(t, series), _mm_set1_ps(2.8853900817779268f)));
+    }
+
+    /// <summary> exp2 for inputs in [-126, 0], the fraction is rounded into [-0.5, 0.5] so a short Taylor series suffices </summary>
+    __m128 Gamma::Exp2(__m128 x)
+    {
+        x = _mm_max_ps(x, _mm_set1_ps(-126.0f));
+
+        const __m128i integer = _mm_cvtps_epi32(x);
+        const __m128 fraction = _mm_mul_ps(_mm_sub_ps(x, _mm_cvtepi32_ps(integer)), _mm_set1_ps(0.6931471805599453f));
+
+        __m128 series = _mm_set1_ps(1.0f / 720.0f);
+        series = _mm_add_ps(_mm_set1_ps(1.0f / 120.0f), _mm_mul_ps(series, fraction));
+        series = _mm_add_ps(_mm_set1_ps(1.0f / 24.0f), _mm_mul_ps(series, fraction));
+        series = _mm_add_ps(_mm_set1_ps(1.0f / 6.0f), _mm_mul_ps(series, fraction));
+        series = _mm_add_ps(_mm_set1_ps(1.0f / 2.0f), _mm_mul_ps(series, fraction));
+        series = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(series, fraction));
+        series = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(series, fraction));
+
+        const __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(integer, _mm_set1_epi32(127)), 23));
+        return _mm_mul_ps(series, scale);
+    }
+
+    /// <summary> Converts four values in [0, 65535] to 16 bit, SSE2 only has a signed saturating pack </summary>
+    __m128i Gamma::PackUnsigned16(__m128 values)
+    {
+        const __m128i bias = _mm_set1_epi32(32768);
+        const __m128i biased = _mm_sub_epi32(_mm_cvttps_epi32(values), bias);
+        return _mm_xor_si128(_mm_packs_epi32(biased, biased), _mm_set1_epi16((int16_t)0x8000));
+    }
+}
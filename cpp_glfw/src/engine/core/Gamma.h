@@ -0,0 +1,48 @@
+#pragma once
+
+#include "engine/core/Base.h"
+
+#include <emmintrin.h>
+
+namespace cpp_glfw
+{
+    struct MonitorGammaRamp;
+
+    struct GammaChannel
+    {
+        float gamma; //exponent applied as 1 / gamma, 1 leaves the channel unchanged
+        float brightness; //offset added after the curve, 0 leaves the channel unchanged
+        float contrast; //scale around mid gray applied after the curve, 1 leaves the channel unchanged
+    };
+
+    struct GammaSettings
+    {
+        GammaChannel red;
+        GammaChannel green;
+        GammaChannel blue;
+
+    public:
+        static GammaSettings FromGamma(float gamma);
+    };
+
+    /// <summary>
+    /// Generates and blends gamma ramps four entries at a time.
+    /// The curve uses a polynomial exp2(log2(x) / gamma) approximation instead of powf,
+    /// entries stay within one step of the powf result for gammas in [0.1, 10].
+    /// All functions write into the buffers of the destination ramp and only allocate when it has to grow.
+    /// </summary>
+    class Gamma
+    {
+    public: CPP_GLFW_INTERNAL_API
+        static bool IsValid(const GammaSettings& settings);
+        static void GenerateRamp(const GammaSettings& settings, uint32_t size, MonitorGammaRamp* ramp);
+        static bool LerpRamp(const MonitorGammaRamp& from, const MonitorGammaRamp& to, float t, MonitorGammaRamp* ramp);
+
+    protected: CPP_GLFW_UTILS
+        static void GenerateChannel(const GammaChannel& channel, uint32_t size, uint16_t* values);
+        static void LerpChannel(const uint16_t* from, const uint16_t* to, float t, uint32_t size, uint16_t* values);
+        static __m128 Log2(__m128 x);
+        static __m128 Exp2(__m128 x);
+        static __m128i PackUnsigned16(__m128 values);
+    };
+}
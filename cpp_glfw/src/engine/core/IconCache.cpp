@@ -0,0 +1,286 @@
+#include "engine/core/Platform.h"
+
+namespace cpp_glfw
+{
+    ////////////////////////////////////// STATIC INIT ///////////////////////////////////////////
+
+    TaggedMap<uint64_t, IconCache::Set, MemoryTag::Window> IconCache::s_Sets = {};
+
+
+
+    ////////////////////////////////////// INTERNAL API ///////////////////////////////////////
+
+    /// <summary> Returns the key of the image set and adds a reference, copying the images the first time the set is seen </summary>
+    uint64_t IconCache::Register(const std::vector<Image*>& images)
+    {
+        uint64_t set = Utils::HashSeed;
+        for (const Image* image : images)
+        {
+            set = Hash(image, set);
+        }
+
+        //a hash hit with different images moves on to the next key, so colliding sets keep their own images and references
+        for (auto it = s_Sets.find(set); it != s_Sets.end(); it = s_Sets.find(++set))
+        {
+            if (IsSameSet(it->second, images))
+            {
+                it->second.refCount++;
+                return set;
+            }
+        }
+
+        Set& registered = s_Sets[set];
+        registered.refCount = 1;
+
+        TaggedVector<Entry, MemoryTag::Window>& entries = registered.images;
+        entries.resize(images.size());
+
+        for (size_t i = 0; i < images.size(); i++)
+        {
+            const Image* image = images[i];
+            entries[i].pixels.assign(image->pixels, image->pixels + (size_t)image->width * image->height * 4);
+            entries[i].image = { image->width, image->height, entries[i].pixels.data() };
+        }
+
+        return set;
+    }
+
+    void IconCache::Release(uint64_t set)
+    {
+        auto it = s_Sets.find(set);
+        if (it == s_Sets.end())
+        {
+            return;
+        }
+
+        if (--it->second.refCount == 0)
+        {
+            s_Sets.erase(it);
+        }
+    }
+
+    /// <summary> Returns an image of exactly the requested size, the pointer stays valid until the set is released </summary>
+    const Image* IconCache::GetIcon(uint64_t set, int32_t width, int32_t height)
+    {
+        auto setIt = s_Sets.find(set);
+        if (setIt == s_Sets.end())
+        {
+            CPP_GLFW_ERROR("Icon set was not registered!");
+            return nullptr;
+        }
+
+        //prefer the smallest image that needs no upscaling, otherwise the largest one
+        const Image* source = nullptr;
+        Set& registered = setIt->second;
+
+        for (const Entry& entry : registered.images)
+        {
+            const Image* image = &entry.image;
+
+            if (image->width == width
+                && image->height == height)
+            {
+                return image;
+            }
+
+            const bool covers = image->width >= width && image->height >= height;
+            const bool sourceCovers = source && source->width >= width && source->height >= height;
+
+            if (!source
+                || (covers && !sourceCovers)
+                || (covers && sourceCovers && image->width * image->height < source->width * source->height)
+                || (!covers && !sourceCovers && image->width * image->height > source->width * source->height))
+            {
+                source = image;
+            }
+        }
+
+        const uint64_t key = (uint64_t)width << 32 | (uint32_t)height;
+
+        auto iconIt = registered.sizes.find(key);
+        if (iconIt != registered.sizes.end())
+        {
+            return &iconIt->second.image;
+        }
+
+        Entry& icon = registered.sizes[key];
+        icon.pixels.resize((size_t)width * height * 4);
+        icon.image = { width, height, icon.pixels.data() };
+
+        Resample(source, width, height, icon.pixels.data());
+        return &icon.image;
+    }
+
+    void IconCache::Terminate()
+    {
+        //swapped out instead of cleared so the buckets are freed before the allocator goes away
+        TaggedMap<uint64_t, Set, MemoryTag::Window>().swap(s_Sets);
+    }
+
+
+
+    ///////////////////////////////////////// UTILS ///////////////////////////////////////////
+
+    /// <summary> Large icons are hashed on every SetIcon call, so the pixels go through the word-at-a-time hash </summary>
+    uint64_t IconCache::Hash(const Image* image, uint64_t seed)
+    {
+        const uint64_t hash = Utils::HashWord((uint64_t)image->width << 32 | (uint32_t)image->height, seed);
+        return Utils::Hash(image->pixels, (size_t)image->width * image->height * 4, hash);
+    }
+
+    bool IconCache::IsSameSet(const Set& set, const std::vector<Image*>& images)
+    {
+        if (set.images.size() != images.size())
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < images.size(); i++)
+        {
+            const Image& registered = set.images[i].image;
+            const Image* image = images[i];
+
+            if (registered.width != image->width
+                || registered.height != image->height
+                || memcmp(registered.pixels, image->pixels, set.images[i].pixels.size()) != 0)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /// <summary> Filters in premultiplied alpha, so transparent pixels do not bleed their color into the edges </summary>
+    void IconCache::Resample(const Image* source, int32_t width, int32_t height, uint8_t* target)
+    {
+        TaggedVector<Contribution, MemoryTag::Window> columns, rows;
+        TaggedVector<float, MemoryTag::Window> columnWeights, rowWeights;
+        ComputeContributions(source->width, width, &columns, &columnWeights);
+        ComputeContributions(source->height, height, &rows, &rowWeights);
+
+        TaggedVector<float, MemoryTag::Window> premultiplied((size_t)source->width * source->height * 4);
+        for (size_t i = 0; i < premultiplied.size(); i += 4)
+        {
+            const float alpha = source->pixels[i + 3] / 255.0f;
+            premultiplied[i + 0] = source->pixels[i + 0] * alpha;
+            premultiplied[i + 1] = source->pixels[i + 1] * alpha;
+            premultiplied[i + 2] = source->pixels[i + 2] * alpha;
+            premultiplied[i + 3] = source->pixels[i + 3];
+        }
+
+        //horizontal pass over every source row
+        TaggedVector<float, MemoryTag::Window> horizontal((size_t)width * source->height * 4);
+        for (int32_t y = 0; y < source->height; y++)
+        {
+            const float* sourceRow = &premultiplied[(size_t)y * source->width * 4];
+            float* targetRow = &horizontal[(size_t)y * width * 4];
+
+            for (int32_t x = 0; x < width; x++)
+            {
+                const Contribution& contribution = columns[x];
+                const float* weights = &columnWeights[contribution.weights];
+                const float* pixel = &sourceRow[contribution.first * 4];
+                float sum[4] = {};
+
+                for (int32_t i = 0; i < contribution.count; i++, pixel += 4)
+                {
+                    sum[0] += pixel[0] * weights[i];
+                    sum[1] += pixel[1] * weights[i];
+                    sum[2] += pixel[2] * weights[i];
+                    sum[3] += pixel[3] * weights[i];
+                }
+
+                memcpy(&targetRow[x * 4], sum, sizeof(sum));
+            }
+        }
+
+        //vertical pass, then back to straight alpha
+        for (int32_t y = 0; y < height; y++)
+        {
+            const Contribution& contribution = rows[y];
+            const float* weights = &rowWeights[contribution.weights];
+            uint8_t* targetRow = target + (size_t)y * width * 4;
+
+            for (int32_t x = 0; x < width; x++)
+            {
+                float sum[4] = {};
+
+                for (int32_t i = 0; i < contribution.count; i++)
+                {
+                    const float* pixel = &horizontal[((size_t)(contribution.first + i) * width + x) * 4];
+                    sum[0] += pixel[0] * weights[i];
+                    sum[1] += pixel[1] * weights[i];
+                    sum[2] += pixel[2] * weights[i];
+                    sum[3] += pixel[3] * weights[i];
+                }
+
+                //lanczos lobes can overshoot, so everything is clamped
+                const float alpha = std::min(std::max(sum[3], 0.0f), 255.0f);
+                const float scale = alpha > 0.0f ? 255.0f / alpha : 0.0f;
+
+                for (int32_t c = 0; c < 3; c++)
+                {
+                    targetRow[x * 4 + c] = (uint8_t)(std::min(std::max(sum[c] * scale, 0.0f), 255.0f) + 0.5f);
+                }
+                targetRow[x * 4 + 3] = (uint8_t)(alpha + 0.5f);
+            }
+        }
+    }
+
+    void IconCache::ComputeContributions(int32_t sourceSize, int32_t targetSize, TaggedVector<Contribution, MemoryTag::Window>* contributions, TaggedVector<float, MemoryTag::Window>* weights)
+    {
+        const float scale = (float)sourceSize / (float)targetSize;
+        const float filterScale = std::max(scale, 1.0f);
+        const float support = 3.0f * filterScale;
+
+        contributions->resize(targetSize);
+
+        for (int32_t i = 0; i < targetSize; i++)
+        {
+            const float center = (i + 0.5f) * scale;
+            const int32_t first = std::max((int32_t)floorf(center - support), 0);
+            const int32_t last = std::min((int32_t)ceilf(center + support), sourceSize);
+
+            Contribution& contribution = (*contributions)[i];
+            contribution.first = first;
+            contribution.count = last - first;
+            contribution.weights = (int32_t)weights->size();
+
+            float total = 0.0f;
+            for (int32_t j = first; j < last; j++)
+            {
+                const float weight = Lanczos((j + 0.5f - center) / filterScale);
+                weights->push_back(weight);
+                total += weight;
+            }
+
+            //taps cut off at the edges would darken the border, so the weights are normalized
+            if (total != 0.0f)
+            {
+                for (int32_t j = 0; j < contribution.count; j++)
+                {
+                    (*weights)[contribution.weights + j] /= total;
+                }
+            }
+        }
+    }
+
+    float IconCache::Lanczos(float x)
+    {
+        const float pi = 3.14159265358979f;
+
+        if (x == 0.0f)
+        {
+            return 1.0f;
+        }
+
+        if (x <= -3.0f
+            || x >= 3.0f)
+        {
+            return 0.0f;
+        }
+
+        return 3.0f * sinf(pi * x) * sinf(pi * x / 3.0f) / (pi * pi * x * x);
+    }
+}
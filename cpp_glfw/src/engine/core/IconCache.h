@@ -0,0 +1,54 @@
+#pragma once
+
+#include "engine/core/Base.h"
+
+namespace cpp_glfw
+{
+    /// <summary>
+    /// Keeps the icon image sets passed to SetIcon and the sizes generated from them.
+    /// A set is keyed by a hash of its contents, so windows and repeated SetIcon calls with the same images share one copy.
+    /// The images are compared on a hash hit, a different set with the same hash gets the next free key.
+    /// Every Register is matched by a Release, the set and the sizes generated from it are freed with the last reference.
+    /// Missing sizes are resampled with a separable Lanczos-3 filter from the smallest image that is at least as large,
+    /// the filter widens with the scale factor so large reductions average every source pixel like a box filter.
+    /// </summary>
+    class IconCache
+    {
+    protected:
+        struct Entry
+        {
+            TaggedVector<uint8_t, MemoryTag::Window> pixels;
+            Image image;
+        };
+
+        struct Set
+        {
+            TaggedVector<Entry, MemoryTag::Window> images; //copies of the registered images
+            TaggedMap<uint64_t, Entry, MemoryTag::Window> sizes; //generated sizes, keyed by width and height
+            uint32_t refCount;
+        };
+
+        struct Contribution
+        {
+            int32_t first; //first source pixel
+            int32_t count;
+            int32_t weights; //offset of the first weight
+        };
+
+    protected:
+        static TaggedMap<uint64_t, Set, MemoryTag::Window> s_Sets;
+
+    public: CPP_GLFW_INTERNAL_API
+        static uint64_t Register(const std::vector<Image*>& images);
+        static void Release(uint64_t set);
+        static const Image* GetIcon(uint64_t set, int32_t width, int32_t height);
+        static void Terminate();
+
+    protected: CPP_GLFW_UTILS
+        static uint64_t Hash(const Image* image, uint64_t seed);
+        static bool IsSameSet(const Set& set, const std::vector<Image*>& images);
+        static void Resample(const Image* source, int32_t width, int32_t height, uint8_t* target);
+        static void ComputeContributions(int32_t sourceSize, int32_t targetSize, TaggedVector<Contribution, MemoryTag::Window>* contributions, TaggedVector<float, MemoryTag::Window>* weights);
+        static float Lanczos(float x);
+    };
+}
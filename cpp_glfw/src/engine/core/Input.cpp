@@ -3,11 +3,19 @@
 namespace cpp_glfw
 {
     bool Input::s_JoysticksInitialized = false;
+    Joystick Input::s_Joysticks[CPP_GLFW_JOYSTICK_COUNT] = {};
 
     bool Input::InitJoysticks()
     {
         if (!Input::s_JoysticksInitialized)
         {
+            for (int32_t jid = 0; jid < CPP_GLFW_JOYSTICK_COUNT; jid++)
+            {
+                s_Joysticks[jid].m_ID = jid;
+            }
+
+            JoystickConditioning::Init();
+
             if (!Input::PlatformInitJoystycks())
             {
                 Input::PlatformTerminateJoystycks();
@@ -18,4 +26,43 @@ namespace cpp_glfw
         Input::s_JoysticksInitialized = true;
         return true;
     }
+
+    void Input::TerminateJoysticks()
+    {
+        if (!Input::s_JoysticksInitialized)
+        {
+            return;
+        }
+
+        Input::PlatformTerminateJoystycks();
+        Input::s_JoysticksInitialized = false;
+    }
+
+    /// <summary> Consumes the snapshots published by the platform polling thread, no device access happens here </summary>
+    void Input::PollJoysticks()
+    {
+        if (!Input::s_JoysticksInitialized)
+        {
+            return;
+        }
+
+        for (Joystick& joystick : s_Joysticks)
+        {
+            joystick.Update();
+        }
+
+        JoystickConditioning::Process();
+    }
+
+    /// <summary> Re-resolves the mappings of connected joysticks after the database changed </summary>
+    void Input::RefreshGamepadMappings()
+    {
+        for (Joystick& joystick : s_Joysticks)
+        {
+            if (joystick.m_Connected)
+            {
+                joystick.RefreshGamepadMapping();
+            }
+        }
+    }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/core/Base.h"
+#include "engine/core/Joystick.h"
 
 namespace cpp_glfw
 {
@@ -8,9 +9,13 @@ namespace cpp_glfw
     {
     public:
         static bool s_JoysticksInitialized;
+        static Joystick s_Joysticks[CPP_GLFW_JOYSTICK_COUNT];
 
     public:
         static bool InitJoysticks();
+        static void TerminateJoysticks();
+        static void PollJoysticks();
+        static void RefreshGamepadMappings();
 
     public:
         static bool PlatformInitJoystycks();
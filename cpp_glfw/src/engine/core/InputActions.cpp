@@ -0,0 +1,368 @@
+#include "engine/core/Platform.h"
+
+namespace cpp_glfw
+{
+    ////////////////////////////////////// STATIC API ///////////////////////////////////////////
+
+    InputBinding InputBinding::FromKey(Key key, KeyMods mods, Key chord, float scale)
+    {
+        return { InputBindingType::Key, (int32_t)key, mods, chord, scale, 0.5f };
+    }
+
+    InputBinding InputBinding::FromMouseButton(MouseButton button, KeyMods mods, float scale)
+    {
+        return { InputBindingType::MouseButton, (int32_t)button, mods, Key::Unknown, scale, 0.5f };
+    }
+
+    InputBinding InputBinding::FromGamepadButton(GamepadButton button, float scale)
+    {
+        return { InputBindingType::GamepadButton, (int32_t)button, KeyMods::None, Key::Unknown, scale, 0.5f };
+    }
+
+    InputBinding InputBinding::FromGamepadAxis(GamepadAxis axis, float scale, float threshold)
+    {
+        return { InputBindingType::GamepadAxis, (int32_t)axis, KeyMods::None, Key::Unknown, scale, threshold };
+    }
+
+
+
+    /////////////////////////////////////// PUBLIC API ////////////////////////////////////////
+
+    int32_t InputActionMap::AddAction(const std::string& name)
+    {
+        if (name.empty())
+        {
+            CPP_GLFW_ERROR("Action name cannot be empty!");
+            return -1;
+        }
+
+        if (GetAction(name) != -1)
+        {
+            CPP_GLFW_ERROR("Action '%s' already exists!", name.c_str());
+            return -1;
+        }
+
+        m_ActionNames.push_back(name);
+        m_ActionBindings.emplace_back();
+        m_Compiled = false;
+
+        return (int32_t)m_ActionNames.size() - 1;
+    }
+
+    int32_t InputActionMap::GetAction(const std::string& name) const
+    {
+        return Utils::indexOf(m_ActionNames, name);
+    }
+
+    const std::string& InputActionMap::GetActionName(int32_t action) const
+    {
+        return m_ActionNames[action];
+    }
+
+    uint32_t InputActionMap::GetActionCount() const
+    {
+        return (uint32_t)m_ActionNames.size();
+    }
+
+
+    bool InputActionMap::AddBinding(int32_t action, const InputBinding& binding)
+    {
+        if (action < 0
+            || action >= (int32_t)m_ActionNames.size())
+        {
+            CPP_GLFW_ERROR("Invalid action %d", action);
+            return false;
+        }
+
+        int32_t codeCount = 0;
+        switch (binding.type)
+        {
+            case InputBindingType::Key:           codeCount = (int32_t)Key::Count; break;
+            case InputBindingType::MouseButton:   codeCount = (int32_t)MouseButton::Count; break;
+            case InputBindingType::GamepadButton: codeCount = (int32_t)GamepadButton::Count; break;
+            case InputBindingType::GamepadAxis:   codeCount = (int32_t)GamepadAxis::Count; break;
+        }
+
+        if (binding.code < 0
+            || binding.code >= codeCount)
+        {
+            CPP_GLFW_ERROR("Invalid binding code %d for action '%s'", binding.code, m_ActionNames[action].c_str());
+            return false;
+        }
+
+        if (binding.chord != Key::Unknown
+            && ((int32_t)binding.chord < 0 || binding.chord >= Key::Count))
+        {
+            CPP_GLFW_ERROR("Invalid chord key %d for action '%s'", (int32_t)binding.chord, m_ActionNames[action].c_str());
+            return false;
+        }
+
+        m_ActionBindings[action].push_back(binding);
+        m_Compiled = false;
+
+        return true;
+    }
+
+    void InputActionMap::ClearBindings(int32_t action)
+    {
+        if (action < 0
+            || action >= (int32_t)m_ActionNames.size())
+        {
+            CPP_GLFW_ERROR("Invalid action %d", action);
+            return;
+        }
+
+        m_ActionBindings[action].clear();
+        m_Compiled = false;
+    }
+
+    bool InputActionMap::Compile()
+    {
+        size_t bindingCount = 0;
+        for (const TaggedVector<InputBinding, MemoryTag::Input>& bindings : m_ActionBindings)
+        {
+            bindingCount += bindings.size();
+        }
+
+        m_ActionFirstBinding.clear();
+        m_BindingTypes.clear();
+        m_BindingCodes.clear();
+        m_BindingMods.clear();
+        m_BindingOwnMods.clear();
+        m_BindingChords.clear();
+        m_BindingScales.clear();
+        m_BindingThresholds.clear();
+
+        m_ActionFirstBinding.reserve(m_ActionBindings.size() + 1);
+        m_BindingTypes.reserve(bindingCount);
+        m_BindingCodes.reserve(bindingCount);
+        m_BindingMods.reserve(bindingCount);
+        m_BindingOwnMods.reserve(bindingCount);
+        m_BindingChords.reserve(bindingCount);
+        m_BindingScales.reserve(bindingCount);
+        m_BindingThresholds.reserve(bindingCount);
+
+        for (const TaggedVector<InputBinding, MemoryTag::Input>& bindings : m_ActionBindings)
+        {
+            m_ActionFirstBinding.push_back((uint32_t)m_BindingTypes.size());
+
+            for (const InputBinding& binding : bindings)
+            {
+                m_BindingTypes.push_back(binding.type);
+                m_BindingCodes.push_back(binding.code);
+                //lock modifiers are toggles, they never take part in matching
+                m_BindingMods.push_back(binding.mods & ~(KeyMods::CapsLock | KeyMods::NumLock));
+                //a binding of a modifier key would otherwise never match, since holding it sets its own modifier
+                m_BindingOwnMods.push_back((binding.type == InputBindingType::Key ? GetKeyMod(binding.code) : KeyMods::None)
+                    | GetKeyMod((int32_t)binding.chord));
+                m_BindingChords.push_back((int32_t)binding.chord);
+                m_BindingScales.push_back(binding.scale);
+                m_BindingThresholds.push_back(binding.threshold);
+            }
+        }
+        m_ActionFirstBinding.push_back((uint32_t)m_BindingTypes.size());
+
+        //keep the state of actions that already existed so edges are not reported twice
+        m_States.resize(m_ActionBindings.size(), InputActionState{});
+
+        m_Compiled = true;
+        return true;
+    }
+
+
+    /// <summary> The state is read on every update until it is replaced, it is ignored while a joystick is set </summary>
+    void InputActionMap::SetGamepadState(const GamepadState* state)
+    {
+        m_Gamepad = state;
+    }
+
+    /// <summary> Reads the gamepad state of the joystick on every update, -1 goes back to the state set by SetGamepadState </summary>
+    void InputActionMap::SetJoystick(int32_t jid)
+    {
+        if (jid < -1
+            || jid >= CPP_GLFW_JOYSTICK_COUNT)
+        {
+            CPP_GLFW_ERROR("Invalid joystick ID %i", jid);
+            return;
+        }
+
+        m_Joystick = jid;
+    }
+
+    int32_t InputActionMap::GetJoystick() const
+    {
+        return m_Joystick;
+    }
+
+    void InputActionMap::Update(const Window* window)
+    {
+        if (!m_Compiled)
+        {
+            Compile();
+        }
+
+        const KeyState* keys = window->m_Keys;
+        const KeyState* mouseButtons = window->m_MouseButtons;
+        const KeyMods heldMods = GetHeldKeyMods(keys);
+
+        //joysticks are polled before the maps are updated, so the state is from the same PollEvents
+        const GamepadState* gamepad = m_Gamepad;
+        if (m_Joystick >= 0)
+        {
+            const Joystick* joystick = Platform::GetJoystick(m_Joystick);
+            gamepad = joystick && joystick->GetGamepadState(&m_JoystickState)
+                ? &m_JoystickState
+                : nullptr;
+        }
+
+        const uint32_t actionCount = (uint32_t)m_States.size();
+        for (uint32_t action = 0; action < actionCount; action++)
+        {
+            float value = 0.0f;
+            bool held = false;
+
+            const uint32_t last = m_ActionFirstBinding[action + 1];
+            for (uint32_t i = m_ActionFirstBinding[action]; i < last; i++)
+            {
+                const int32_t code = m_BindingCodes[i];
+                float bindingValue = 0.0f;
+
+                switch (m_BindingTypes[i])
+                {
+                    case InputBindingType::Key:
+                    case InputBindingType::MouseButton:
+                    {
+                        const KeyState state = m_BindingTypes[i] == InputBindingType::Key
+                            ? keys[code]
+                            : mouseButtons[code];
+
+                        if (state == KeyState::Press
+                            && (heldMods & ~m_BindingOwnMods[i]) == m_BindingMods[i]
+                            && (m_BindingChords[i] < 0 || keys[m_BindingChords[i]] == KeyState::Press))
+                        {
+                            bindingValue = 1.0f;
+                        }
+                        break;
+                    }
+                    case InputBindingType::GamepadButton:
+                    {
+                        if (gamepad
+                            && gamepad->buttons[code] == KeyState::Press)
+                        {
+                            bindingValue = 1.0f;
+                        }
+                        break;
+                    }
+                    case InputBindingType::GamepadAxis:
+                    {
+                        if (gamepad)
+                        {
+                            bindingValue = gamepad->axes[code];
+                        }
+                        break;
+                    }
+                }
+
+                bindingValue *= m_BindingScales[i];
+
+                if (fabsf(bindingValue) >= m_BindingThresholds[i])
+                {
+                    held = true;
+                }
+
+                if (fabsf(bindingValue) > fabsf(value))
+                {
+                    value = bindingValue;
+                }
+            }
+
+            InputActionState& state = m_States[action];
+            state.pressed = held && !state.held;
+            state.released = !held && state.held;
+            state.held = held;
+            state.value = value;
+        }
+    }
+
+
+    const InputActionState* InputActionMap::GetStates() const
+    {
+        return m_States.data();
+    }
+
+    const InputActionState& InputActionMap::GetState(int32_t action) const
+    {
+        return m_States[action];
+    }
+
+    bool InputActionMap::IsHeld(int32_t action) const
+    {
+        return m_States[action].held;
+    }
+
+    bool InputActionMap::WasPressed(int32_t action) const
+    {
+        return m_States[action].pressed;
+    }
+
+    bool InputActionMap::WasReleased(int32_t action) const
+    {
+        return m_States[action].released;
+    }
+
+    float InputActionMap::GetValue(int32_t action) const
+    {
+        return m_States[action].value;
+    }
+
+
+
+    ///////////////////////////////////////// UTILS ///////////////////////////////////////////
+
+    KeyMods InputActionMap::GetHeldKeyMods(const KeyState* keys)
+    {
+        KeyMods mods = KeyMods::None;
+
+        if (keys[(int32_t)Key::LeftShift] == KeyState::Press
+            || keys[(int32_t)Key::RightShift] == KeyState::Press)
+        {
+            mods = mods | KeyMods::Shift;
+        }
+
+        if (keys[(int32_t)Key::LeftControl] == KeyState::Press
+            || keys[(int32_t)Key::RightControl] == KeyState::Press)
+        {
+            mods = mods | KeyMods::Control;
+        }
+
+        if (keys[(int32_t)Key::LeftAlt] == KeyState::Press
+            || keys[(int32_t)Key::RightAlt] == KeyState::Press)
+        {
+            mods = mods | KeyMods::Alt;
+        }
+
+        if (keys[(int32_t)Key::LeftSuper] == KeyState::Press
+            || keys[(int32_t)Key::RightSuper] == KeyState::Press)
+        {
+            mods = mods | KeyMods::Super;
+        }
+
+        return mods;
+    }
+
+    KeyMods InputActionMap::GetKeyMod(int32_t key)
+    {
+        switch ((Key)key)
+        {
+            case Key::LeftShift:
+            case Key::RightShift:   return KeyMods::Shift;
+            case Key::LeftControl:
+            case Key::RightControl: return KeyMods::Control;
+            case Key::LeftAlt:
+            case Key::RightAlt:     return KeyMods::Alt;
+            case Key::LeftSuper:
+            case Key::RightSuper:   return KeyMods::Super;
+            default:                return KeyMods::None;
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "engine/core/Base.h"
+#include "engine/core/Joystick.h"
+
+namespace cpp_glfw
+{
+    class Window;
+
+    enum class InputBindingType
+    {
+        Key = 0,
+        MouseButton = 1,
+        GamepadButton = 2,
+        GamepadAxis = 3
+    };
+
+    struct InputBinding
+    {
+        InputBindingType type;
+        int32_t code; //key, mouse button, gamepad button or gamepad axis depending on type
+        KeyMods mods; //exact modifiers that must be held with the key or mouse button, lock modifiers are ignored
+        Key chord; //second key that must be held for the binding to trigger, Key::Unknown if none
+        float scale; //applied to the binding value, use a negative scale to invert an axis
+        float threshold; //absolute value above which the binding counts as held
+
+    public:
+        static InputBinding FromKey(Key key, KeyMods mods = KeyMods::None, Key chord = Key::Unknown, float scale = 1.0f);
+        static InputBinding FromMouseButton(MouseButton button, KeyMods mods = KeyMods::None, float scale = 1.0f);
+        static InputBinding FromGamepadButton(GamepadButton button, float scale = 1.0f);
+        static InputBinding FromGamepadAxis(GamepadAxis axis, float scale = 1.0f, float threshold = 0.5f);
+    };
+
+    struct InputActionState
+    {
+        float value; //binding value with the largest magnitude
+        bool held;
+        bool pressed; //became held during the last update
+        bool released; //stopped being held during the last update
+    };
+
+    /// <summary>
+    /// Maps keys, mouse buttons, gamepad buttons and axes to named actions.
+    /// Bindings are compiled into flat per-binding tables sorted by action,
+    /// so the per-frame update is a single pass without lookups or allocations.
+    /// The map is evaluated once per Platform::PollEvents for the window it is attached to.
+    /// </summary>
+    class InputActionMap
+    {
+        CPP_GLFW_MEMORY_TAG(MemoryTag::Input)
+
+    protected:
+        std::vector<std::string> m_ActionNames = {}; //returned by reference from GetActionName, so they keep the default allocator
+        TaggedVector<TaggedVector<InputBinding, MemoryTag::Input>, MemoryTag::Input> m_ActionBindings = {};
+        bool m_Compiled = false;
+
+        //compiled tables, bindings of action i are in [m_ActionFirstBinding[i], m_ActionFirstBinding[i + 1])
+        TaggedVector<uint32_t, MemoryTag::Input> m_ActionFirstBinding = {};
+        TaggedVector<InputBindingType, MemoryTag::Input> m_BindingTypes = {};
+        TaggedVector<int32_t, MemoryTag::Input> m_BindingCodes = {};
+        TaggedVector<KeyMods, MemoryTag::Input> m_BindingMods = {};
+        TaggedVector<KeyMods, MemoryTag::Input> m_BindingOwnMods = {}; //modifiers produced by the bound key and chord, not compared
+        TaggedVector<int32_t, MemoryTag::Input> m_BindingChords = {};
+        TaggedVector<float, MemoryTag::Input> m_BindingScales = {};
+        TaggedVector<float, MemoryTag::Input> m_BindingThresholds = {};
+
+        TaggedVector<InputActionState, MemoryTag::Input> m_States = {};
+        const GamepadState* m_Gamepad = nullptr;
+        int32_t m_Joystick = -1; //joystick whose gamepad state is read on every update, -1 for none
+        GamepadState m_JoystickState = {};
+
+    public: CPP_GLFW_PUBLIC_API
+        int32_t AddAction(const std::string& name);
+        int32_t GetAction(const std::string& name) const;
+        const std::string& GetActionName(int32_t action) const;
+        uint32_t GetActionCount() const;
+
+        bool AddBinding(int32_t action, const InputBinding& binding);
+        void ClearBindings(int32_t action);
+        bool Compile();
+
+        void SetGamepadState(const GamepadState* state);
+        void SetJoystick(int32_t jid);
+        int32_t GetJoystick() const;
+        void Update(const Window* window);
+
+        const InputActionState* GetStates() const;
+        const InputActionState& GetState(int32_t action) const;
+        bool IsHeld(int32_t action) const;
+        bool WasPressed(int32_t action) const;
+        bool WasReleased(int32_t action) const;
+        float GetValue(int32_t action) const;
+
+    protected: CPP_GLFW_UTILS
+        static KeyMods GetHeldKeyMods(const KeyState* keys);
+        static KeyMods GetKeyMod(int32_t key);
+    };
+}
@@ -2,5 +2,403 @@
 
 namespace cpp_glfw
 {
+    /////////////////////////////////////// PUBLIC API ////////////////////////////////////////
 
+    int32_t Joystick::GetID() const
+    {
+        return m_ID;
+    }
+
+    bool Joystick::IsPresent() const
+    {
+        return m_Connected;
+    }
+
+    const std::string& Joystick::GetName() const
+    {
+        return m_Name;
+    }
+
+    const std::string& Joystick::GetGUID() const
+    {
+        return m_GUID;
+    }
+
+    /// <summary> Returns the conditioned axes, followed by the hat axes when hats are reported as axes </summary>
+    const float* Joystick::GetAxes(int32_t* count) const
+    {
+        if (count) *count = m_Connected ? GetConditionedAxisCount() : 0;
+
+        return m_Connected ? JoystickConditioning::GetOutput(m_ID) : nullptr;
+    }
+
+    /// <summary> Returns the axes as reported by the device, before conditioning </summary>
+    const float* Joystick::GetRawAxes(int32_t* count) const
+    {
+        if (count) *count = m_Connected ? m_AxisCount : 0;
+
+        return m_Connected ? m_Axes : nullptr;
+    }
+
+    const KeyState* Joystick::GetButtons(int32_t* count) const
+    {
+        if (count) *count = m_Connected ? m_ButtonCount : 0;
+
+        return m_Connected ? m_Buttons : nullptr;
+    }
+
+    const HatState* Joystick::GetHats(int32_t* count) const
+    {
+        if (count) *count = m_Connected ? m_HatCount : 0;
+
+        return m_Connected ? m_Hats : nullptr;
+    }
+
+    bool Joystick::IsGamepad() const
+    {
+        return m_Connected && m_IsGamepad;
+    }
+
+    const char* Joystick::GetGamepadName() const
+    {
+        return IsGamepad() ? m_Mapping.name : nullptr;
+    }
+
+    bool Joystick::GetGamepadState(GamepadState* state) const
+    {
+        memset(state, 0, sizeof(GamepadState));
+
+        if (!IsGamepad())
+        {
+            return false;
+        }
+
+        const float* axes = JoystickConditioning::GetOutput(m_ID);
+
+        for (int32_t i = 0; i < (int32_t)GamepadButton::Count; i++)
+        {
+            const GamepadElement& element = m_Mapping.buttons[i];
+
+            if (element.type == GamepadElementType::Axis)
+            {
+                const float value = axes[element.index] * element.axisScale + element.axisOffset;
+
+                //half axes are pressed on their active side, full axes on the positive side
+                if (element.axisOffset < 0
+                    || (element.axisOffset == 0 && element.axisScale > 0))
+                {
+                    if (value >= 0.0f)
+                    {
+                        state->buttons[i] = KeyState::Press;
+                    }
+                }
+                else
+                {
+                    if (value <= 0.0f)
+                    {
+                        state->buttons[i] = KeyState::Press;
+                    }
+                }
+            }
+            else if (element.type == GamepadElementType::HatBit)
+            {
+                if ((uint8_t)m_Hats[element.index >> 4] & (element.index & 0xf))
+                {
+                    state->buttons[i] = KeyState::Press;
+                }
+            }
+            else if (element.type == GamepadElementType::Button)
+            {
+                state->buttons[i] = m_Buttons[element.index];
+            }
+        }
+
+        for (int32_t i = 0; i < (int32_t)GamepadAxis::Count; i++)
+        {
+            const GamepadElement& element = m_Mapping.axes[i];
+
+            if (element.type == GamepadElementType::Axis)
+            {
+                const float value = axes[element.index] * element.axisScale + element.axisOffset;
+                state->axes[i] = Utils::fminf(Utils::fmaxf(value, -1.0f), 1.0f);
+            }
+            else if (element.type == GamepadElementType::HatBit)
+            {
+                state->axes[i] = ((uint8_t)m_Hats[element.index >> 4] & (element.index & 0xf)) ? 1.0f : -1.0f;
+            }
+            else if (element.type == GamepadElementType::Button)
+            {
+                state->axes[i] = m_Buttons[element.index] == KeyState::Press ? 1.0f : -1.0f;
+            }
+        }
+
+        return true;
+    }
+
+    void Joystick::SetAxisConditioning(int32_t axis, const JoystickAxisConditioning& conditioning)
+    {
+        if (axis < 0 || axis >= CPP_GLFW_JOYSTICK_MAX_AXES)
+        {
+            CPP_GLFW_ERROR("Invalid joystick axis %d", axis);
+            return;
+        }
+
+        JoystickConditioning::SetConditioning(m_ID, axis, conditioning);
+    }
+
+    const JoystickAxisConditioning& Joystick::GetAxisConditioning(int32_t axis) const
+    {
+        return JoystickConditioning::GetConditioning(m_ID, std::min(std::max(axis, 0), CPP_GLFW_JOYSTICK_MAX_AXES - 1));
+    }
+
+    void Joystick::SetHatsAsAxes(bool enabled)
+    {
+        if (m_HatsAsAxes == enabled)
+        {
+            return;
+        }
+
+        m_HatsAsAxes = enabled;
+
+        for (int32_t axis = m_AxisCount; axis < CPP_GLFW_JOYSTICK_MAX_AXES; axis++)
+        {
+            JoystickConditioning::SetInput(m_ID, axis, 0.0f);
+        }
+
+        for (int32_t i = 0; i < m_HatCount; i++)
+        {
+            UpdateHatAxes(i);
+        }
+    }
+
+    bool Joystick::GetHatsAsAxes() const
+    {
+        return m_HatsAsAxes;
+    }
+
+
+
+    ////////////////////////////////////// INTERNAL API ///////////////////////////////////////
+
+    /// <summary> Polling thread only. The returned snapshot has undefined content and must be filled in entirely </summary>
+    JoystickSnapshot* Joystick::GetBackSnapshot()
+    {
+        return &m_Snapshots[m_BackSnapshot];
+    }
+
+    /// <summary> Polling thread only. Hands the back snapshot over to the event thread </summary>
+    void Joystick::PublishSnapshot()
+    {
+        const uint32_t previous = m_SharedSnapshot.exchange(m_BackSnapshot | SnapshotDirty, std::memory_order_acq_rel);
+        m_BackSnapshot = previous & SnapshotIndexMask;
+    }
+
+
+
+    ///////////////////////////////////////// UTILS ///////////////////////////////////////////
+
+    bool Joystick::AcquireSnapshot()
+    {
+        if (!(m_SharedSnapshot.load(std::memory_order_relaxed) & SnapshotDirty))
+        {
+            return false;
+        }
+
+        const uint32_t previous = m_SharedSnapshot.exchange(m_FrontSnapshot, std::memory_order_acq_rel);
+        m_FrontSnapshot = previous & SnapshotIndexMask;
+        return true;
+    }
+
+    /// <summary> Called once per PollEvents, turns the latest published snapshot into joystick events </summary>
+    void Joystick::Update()
+    {
+        if (!AcquireSnapshot())
+        {
+            return;
+        }
+
+        const JoystickSnapshot& snapshot = m_Snapshots[m_FrontSnapshot];
+
+        if (!snapshot.connected)
+        {
+            if (m_Connected)
+            {
+                OnJoystickDisconnected();
+            }
+            return;
+        }
+
+        //the device was replaced between two reads, so the old one is reported as gone before the new one connects
+        if (m_Connected
+            && m_Connection != snapshot.connection)
+        {
+            OnJoystickDisconnected();
+        }
+
+        if (!m_Connected)
+        {
+            m_Connection = snapshot.connection;
+            m_Name = snapshot.name;
+            m_GUID = snapshot.guid;
+            m_AxisCount = std::min(snapshot.axisCount, CPP_GLFW_JOYSTICK_MAX_AXES);
+            m_ButtonCount = std::min(snapshot.buttonCount, CPP_GLFW_JOYSTICK_MAX_BUTTONS);
+            m_HatCount = std::min(snapshot.hatCount, CPP_GLFW_JOYSTICK_MAX_HATS);
+            RefreshGamepadMapping();
+            OnJoystickConnected();
+        }
+
+        for (int32_t i = 0; i < m_AxisCount; i++)
+        {
+            if (m_Axes[i] != snapshot.axes[i])
+            {
+                OnJoystickAxis(i, snapshot.axes[i]);
+            }
+        }
+
+        for (int32_t i = 0; i < m_ButtonCount; i++)
+        {
+            if (m_Buttons[i] != (snapshot.buttons[i] ? KeyState::Press : KeyState::Release))
+            {
+                OnJoystickButton(i, snapshot.buttons[i]);
+            }
+        }
+
+        for (int32_t i = 0; i < m_HatCount; i++)
+        {
+            if (m_Hats[i] != (HatState)snapshot.hats[i])
+            {
+                OnJoystickHat(i, snapshot.hats[i]);
+            }
+        }
+    }
+
+    /// <summary> Copies the database mapping for this device, if it is usable with the device's inputs </summary>
+    void Joystick::RefreshGamepadMapping()
+    {
+        m_IsGamepad = false;
+
+        uint8_t guid[16];
+        if (!GamepadMappings::ParseGUID(m_GUID.c_str(), m_GUID.size(), guid))
+        {
+            return;
+        }
+
+        const GamepadMapping* mapping = GamepadMappings::Find(guid);
+        if (!mapping)
+        {
+            return;
+        }
+
+        for (const GamepadElement& element : mapping->buttons)
+        {
+            if (!IsValidGamepadElement(element))
+            {
+                CPP_GLFW_WARN("Gamepad mapping for '%s' references inputs the device does not have", mapping->name);
+                return;
+            }
+        }
+
+        for (const GamepadElement& element : mapping->axes)
+        {
+            if (!IsValidGamepadElement(element))
+            {
+                CPP_GLFW_WARN("Gamepad mapping for '%s' references inputs the device does not have", mapping->name);
+                return;
+            }
+        }
+
+        m_Mapping = *mapping;
+        m_IsGamepad = true;
+    }
+
+    bool Joystick::IsValidGamepadElement(const GamepadElement& element) const
+    {
+        switch (element.type)
+        {
+            case GamepadElementType::Axis:   return element.index < m_AxisCount;
+            case GamepadElementType::Button: return element.index < m_ButtonCount;
+            case GamepadElementType::HatBit: return (element.index >> 4) < m_HatCount;
+            default:                         return true;
+        }
+    }
+
+    int32_t Joystick::GetConditionedAxisCount() const
+    {
+        return m_HatsAsAxes
+            ? std::min(m_AxisCount + m_HatCount * 2, CPP_GLFW_JOYSTICK_MAX_AXES)
+            : m_AxisCount;
+    }
+
+    /// <summary> Writes a hat as an x and a y axis after the device axes, up is negative like on the sticks </summary>
+    void Joystick::UpdateHatAxes(int32_t hat)
+    {
+        const int32_t axis = m_AxisCount + hat * 2;
+        if (!m_HatsAsAxes
+            || axis >= CPP_GLFW_JOYSTICK_MAX_AXES)
+        {
+            return;
+        }
+
+        const HatState state = m_Hats[hat];
+        const float x = ((state & HatState::Right) == HatState::Right ? 1.0f : 0.0f) - ((state & HatState::Left) == HatState::Left ? 1.0f : 0.0f);
+        const float y = ((state & HatState::Down) == HatState::Down ? 1.0f : 0.0f) - ((state & HatState::Up) == HatState::Up ? 1.0f : 0.0f);
+
+        JoystickConditioning::SetInput(m_ID, axis, x);
+        if (axis + 1 < CPP_GLFW_JOYSTICK_MAX_AXES)
+        {
+            JoystickConditioning::SetInput(m_ID, axis + 1, y);
+        }
+    }
+
+
+
+    ///////////////////////////////////// EVENT INPUT API /////////////////////////////////////
+
+    void Joystick::OnJoystickConnected()
+    {
+        m_Connected = true;
+
+        if (Platform::s_Callbacks.joystickConnected)
+        {
+            Platform::s_Callbacks.joystickConnected(m_ID, true);
+        }
+    }
+
+    void Joystick::OnJoystickDisconnected()
+    {
+        m_Connected = false;
+
+        if (Platform::s_Callbacks.joystickDisconnected)
+        {
+            Platform::s_Callbacks.joystickDisconnected(m_ID, false);
+        }
+
+        m_Name.clear();
+        m_GUID.clear();
+        m_IsGamepad = false;
+        m_AxisCount = 0;
+        m_ButtonCount = 0;
+        m_HatCount = 0;
+        memset(m_Axes, 0, sizeof(m_Axes));
+        memset(m_Buttons, 0, sizeof(m_Buttons));
+        memset(m_Hats, 0, sizeof(m_Hats));
+        JoystickConditioning::ResetJoystick(m_ID);
+    }
+
+    void Joystick::OnJoystickAxis(int32_t axis, float value)
+    {
+        m_Axes[axis] = value;
+        JoystickConditioning::SetInput(m_ID, axis, value);
+    }
+
+    void Joystick::OnJoystickButton(int32_t button, int8_t value)
+    {
+        m_Buttons[button] = value ? KeyState::Press : KeyState::Release;
+    }
+
+    void Joystick::OnJoystickHat(int32_t hat, int8_t value)
+    {
+        m_Hats[hat] = (HatState)value;
+        UpdateHatAxes(hat);
+    }
 }
@@ -1,14 +1,107 @@
 #pragma once
 
 #include "engine/core/Base.h"
+#include "engine/core/GamepadMappings.h"
+
+#include <atomic>
+
+#define CPP_GLFW_JOYSTICK_COUNT 16
+#define CPP_GLFW_JOYSTICK_MAX_AXES 8
+#define CPP_GLFW_JOYSTICK_MAX_BUTTONS 32
+#define CPP_GLFW_JOYSTICK_MAX_HATS 4
 
 namespace cpp_glfw
 {
+    struct JoystickAxisConditioning;
+
+    struct GamepadState
+    {
+        KeyState buttons[(int32_t)GamepadButton::Count];
+        float axes[(int32_t)GamepadAxis::Count];
+    };
+
+    /// <summary>
+    /// Complete device state written by the platform polling thread.
+    /// Each published snapshot must be filled in entirely.
+    /// </summary>
+    struct JoystickSnapshot
+    {
+        bool connected;
+        uint32_t connection; //changes when a different device takes the slot, even between two reads of the event thread
+        char name[128];
+        char guid[33];
+        int32_t axisCount;
+        int32_t buttonCount;
+        int32_t hatCount;
+        float axes[CPP_GLFW_JOYSTICK_MAX_AXES];
+        uint8_t buttons[CPP_GLFW_JOYSTICK_MAX_BUTTONS];
+        uint8_t hats[CPP_GLFW_JOYSTICK_MAX_HATS];
+    };
+
     class Joystick
     {
-    public:
+    protected:
+        int32_t m_ID = -1;
+        bool m_Connected = false;
+        uint32_t m_Connection = 0; //JoystickSnapshot::connection of the connected device
+        std::string m_Name = {};
+        std::string m_GUID = {};
+        int32_t m_AxisCount = 0;
+        int32_t m_ButtonCount = 0;
+        int32_t m_HatCount = 0;
+        float m_Axes[CPP_GLFW_JOYSTICK_MAX_AXES] = {};
+        KeyState m_Buttons[CPP_GLFW_JOYSTICK_MAX_BUTTONS] = {};
+        HatState m_Hats[CPP_GLFW_JOYSTICK_MAX_HATS] = {};
+        bool m_HatsAsAxes = false; //hats are reported as two extra axes each, after the device axes
+
+        //remap table resolved from the mapping database when the device connects
+        GamepadMapping m_Mapping = {};
+        bool m_IsGamepad = false;
+
+        //triple buffer shared with the polling thread, the writer and the reader
+        //each own one buffer and swap it with the shared one, so neither ever waits
+        JoystickSnapshot m_Snapshots[3] = {};
+        std::atomic<uint32_t> m_SharedSnapshot = { 1 }; //index of the shared buffer, SnapshotDirty when unread
+        uint32_t m_BackSnapshot = 2; //owned by the polling thread
+        uint32_t m_FrontSnapshot = 0; //owned by the event thread
+
+        static const uint32_t SnapshotIndexMask = 0x3;
+        static const uint32_t SnapshotDirty = 0x4;
 
     public:
+        friend class Input;
+
+    public: CPP_GLFW_PUBLIC_API
+        int32_t GetID() const;
+        bool IsPresent() const;
+        const std::string& GetName() const;
+        const std::string& GetGUID() const;
+        const float* GetAxes(int32_t* count) const;
+        const float* GetRawAxes(int32_t* count) const;
+        const KeyState* GetButtons(int32_t* count) const;
+        const HatState* GetHats(int32_t* count) const;
+        bool IsGamepad() const;
+        const char* GetGamepadName() const;
+        bool GetGamepadState(GamepadState* state) const;
+
+        void SetAxisConditioning(int32_t axis, const JoystickAxisConditioning& conditioning);
+        const JoystickAxisConditioning& GetAxisConditioning(int32_t axis) const;
+        void SetHatsAsAxes(bool enabled);
+        bool GetHatsAsAxes() const;
+
+    public: CPP_GLFW_INTERNAL_API
+        JoystickSnapshot* GetBackSnapshot();
+        void PublishSnapshot();
+
+    protected: CPP_GLFW_UTILS
+        bool AcquireSnapshot();
+        void Update();
+        void RefreshGamepadMapping();
+        bool IsValidGamepadElement(const GamepadElement& element) const;
+        int32_t GetConditionedAxisCount() const;
+        void UpdateHatAxes(int32_t hat);
+
+    protected: CPP_GLFW_EVENT_INPUT_API
         void OnJoystickConnected();
         void OnJoystickDisconnected();
         void OnJoystickAxis(int32_t axis, float value);
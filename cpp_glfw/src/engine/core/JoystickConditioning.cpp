@@ -0,0 +1,156 @@
+#include "engine/core/Platform.h"
+
+#include <xmmintrin.h>
+
+namespace cpp_glfw
+{
+    ////////////////////////////////////// STATIC INIT ///////////////////////////////////////////
+
+    alignas(16) float JoystickConditioning::s_Input[CPP_GLFW_JOYSTICK_AXIS_LANES] = {};
+    alignas(16) float JoystickConditioning::s_Paired[CPP_GLFW_JOYSTICK_AXIS_LANES] = {};
+    alignas(16) float JoystickConditioning::s_Output[CPP_GLFW_JOYSTICK_AXIS_LANES] = {};
+    alignas(16) float JoystickConditioning::s_DeadzoneInner[CPP_GLFW_JOYSTICK_AXIS_LANES] = {};
+    alignas(16) float JoystickConditioning::s_DeadzoneScale[CPP_GLFW_JOYSTICK_AXIS_LANES] = {};
+    alignas(16) float JoystickConditioning::s_CurveLinear[CPP_GLFW_JOYSTICK_AXIS_LANES] = {};
+    alignas(16) float JoystickConditioning::s_CurveQuadratic[CPP_GLFW_JOYSTICK_AXIS_LANES] = {};
+    alignas(16) float JoystickConditioning::s_CurveCubic[CPP_GLFW_JOYSTICK_AXIS_LANES] = {};
+    alignas(16) float JoystickConditioning::s_Response[CPP_GLFW_JOYSTICK_AXIS_LANES] = {};
+    int8_t JoystickConditioning::s_PairedAxis[CPP_GLFW_JOYSTICK_AXIS_LANES] = {};
+    JoystickAxisConditioning JoystickConditioning::s_Conditioning[CPP_GLFW_JOYSTICK_AXIS_LANES] = {};
+    bool JoystickConditioning::s_Initialized = false;
+
+
+
+    ////////////////////////////////////// STATIC API ///////////////////////////////////////////
+
+    JoystickAxisConditioning JoystickAxisConditioning::Default()
+    {
+        return { 0.0f, 1.0f, ResponseCurve::Linear, 0.0f, -1 };
+    }
+
+    JoystickAxisConditioning JoystickAxisConditioning::Axial(float inner, float outer, ResponseCurve curve)
+    {
+        return { inner, outer, curve, 0.0f, -1 };
+    }
+
+    JoystickAxisConditioning JoystickAxisConditioning::Radial(int32_t pairedAxis, float inner, float outer, ResponseCurve curve)
+    {
+        return { inner, outer, curve, 0.0f, pairedAxis };
+    }
+
+
+
+    ////////////////////////////////////// INTERNAL API ///////////////////////////////////////
+
+    void JoystickConditioning::Init()
+    {
+        if (s_Initialized)
+        {
+            return;
+        }
+
+        for (int32_t jid = 0; jid < CPP_GLFW_JOYSTICK_COUNT; jid++)
+        {
+            for (int32_t axis = 0; axis < CPP_GLFW_JOYSTICK_MAX_AXES; axis++)
+            {
+                SetConditioning(jid, axis, JoystickAxisConditioning::Default());
+            }
+        }
+
+        s_Initialized = true;
+    }
+
+    /// <summary> Stores the conditioning as lane parameters, the default conditioning passes values through unchanged </summary>
+    void JoystickConditioning::SetConditioning(int32_t jid, int32_t axis, const JoystickAxisConditioning& conditioning)
+    {
+        const int32_t lane = jid * CPP_GLFW_JOYSTICK_MAX_AXES + axis;
+
+        const float inner = Utils::fminf(Utils::fmaxf(conditioning.deadzoneInner, 0.0f), 1.0f);
+        const float outer = Utils::fminf(Utils::fmaxf(conditioning.deadzoneOuter, inner + 1e-4f), 1.0f + 1e-4f);
+
+        s_Conditioning[lane] = conditioning;
+        s_DeadzoneInner[lane] = inner;
+        s_DeadzoneScale[lane] = 1.0f / (outer - inner);
+
+        //curves are evaluated as m * (linear + m * (quadratic + m * cubic))
+        s_CurveLinear[lane] = conditioning.curve == ResponseCurve::Linear ? 1.0f : 0.0f;
+        s_CurveQuadratic[lane] = conditioning.curve == ResponseCurve::Quadratic ? 1.0f : 0.0f;
+        s_CurveCubic[lane] = conditioning.curve == ResponseCurve::Cubic ? 1.0f : 0.0f;
+
+        s_Response[lane] = 1.0f - Utils::fminf(Utils::fmaxf(conditioning.smoothing, 0.0f), 0.99f);
+
+        s_PairedAxis[lane] = conditioning.pairedAxis >= 0
+            && conditioning.pairedAxis < CPP_GLFW_JOYSTICK_MAX_AXES
+            && conditioning.pairedAxis != axis
+            ? (int8_t)conditioning.pairedAxis
+            : -1;
+    }
+
+    const JoystickAxisConditioning& JoystickConditioning::GetConditioning(int32_t jid, int32_t axis)
+    {
+        return s_Conditioning[jid * CPP_GLFW_JOYSTICK_MAX_AXES + axis];
+    }
+
+    void JoystickConditioning::SetInput(int32_t jid, int32_t axis, float value)
+    {
+        s_Input[jid * CPP_GLFW_JOYSTICK_MAX_AXES + axis] = value;
+    }
+
+    /// <summary> Clears the inputs and the smoothing state of a joystick, its conditioning is kept </summary>
+    void JoystickConditioning::ResetJoystick(int32_t jid)
+    {
+        const int32_t first = jid * CPP_GLFW_JOYSTICK_MAX_AXES;
+
+        memset(&s_Input[first], 0, CPP_GLFW_JOYSTICK_MAX_AXES * sizeof(float));
+        memset(&s_Output[first], 0, CPP_GLFW_JOYSTICK_MAX_AXES * sizeof(float));
+    }
+
+    const float* JoystickConditioning::GetOutput(int32_t jid)
+    {
+        return &s_Output[jid * CPP_GLFW_JOYSTICK_MAX_AXES];
+    }
+
+    /// <summary> Conditions all lanes, called once per PollEvents after the joysticks consumed their snapshots </summary>
+    void JoystickConditioning::Process()
+    {
+        //radial deadzones need the magnitude of the stick, gather the paired values first
+        //so the vector pass treats axial lanes as radial ones paired with a zero axis
+        for (int32_t lane = 0; lane < CPP_GLFW_JOYSTICK_AXIS_LANES; lane++)
+        {
+            const int8_t paired = s_PairedAxis[lane];
+            s_Paired[lane] = paired >= 0
+                ? s_Input[(lane & ~(CPP_GLFW_JOYSTICK_MAX_AXES - 1)) + paired]
+                : 0.0f;
+        }
+
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 epsilon = _mm_set1_ps(1e-6f);
+
+        for (int32_t lane = 0; lane < CPP_GLFW_JOYSTICK_AXIS_LANES; lane += 4)
+        {
+            const __m128 value = _mm_load_ps(&s_Input[lane]);
+            const __m128 paired = _mm_load_ps(&s_Paired[lane]);
+
+            const __m128 magnitude = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(value, value), _mm_mul_ps(paired, paired)));
+
+            //remap the magnitude between the deadzones to [0, 1]
+            __m128 m = _mm_mul_ps(_mm_sub_ps(magnitude, _mm_load_ps(&s_DeadzoneInner[lane])), _mm_load_ps(&s_DeadzoneScale[lane]));
+            m = _mm_min_ps(_mm_max_ps(m, zero), one);
+
+            __m128 response = _mm_add_ps(_mm_load_ps(&s_CurveQuadratic[lane]), _mm_mul_ps(m, _mm_load_ps(&s_CurveCubic[lane])));
+            response = _mm_add_ps(_mm_load_ps(&s_CurveLinear[lane]), _mm_mul_ps(m, response));
+            response = _mm_mul_ps(m, response);
+
+            //scale the value along its direction, lanes at rest stay at zero instead of dividing by zero
+            const __m128 moving = _mm_cmpgt_ps(magnitude, epsilon);
+            const __m128 scale = _mm_and_ps(moving, _mm_div_ps(response, _mm_max_ps(magnitude, epsilon)));
+            const __m128 target = _mm_mul_ps(value, scale);
+
+            const __m128 previous = _mm_load_ps(&s_Output[lane]);
+            const __m128 output = _mm_add_ps(previous, _mm_mul_ps(_mm_sub_ps(target, previous), _mm_load_ps(&s_Response[lane])));
+
+            _mm_store_ps(&s_Output[lane], output);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "engine/core/Base.h"
+#include "engine/core/Joystick.h"
+
+#define CPP_GLFW_JOYSTICK_AXIS_LANES (CPP_GLFW_JOYSTICK_COUNT * CPP_GLFW_JOYSTICK_MAX_AXES)
+
+namespace cpp_glfw
+{
+    enum class ResponseCurve
+    {
+        Linear = 0,
+        Quadratic = 1,
+        Cubic = 2
+    };
+
+    struct JoystickAxisConditioning
+    {
+        float deadzoneInner; //magnitude below which the axis reads zero
+        float deadzoneOuter; //magnitude above which the axis reads full deflection
+        ResponseCurve curve; //applied to the magnitude remapped between the deadzones
+        float smoothing; //exponential smoothing per PollEvents in [0, 1), 0 disables it
+        int32_t pairedAxis; //other axis of the stick for a radial deadzone, -1 for an axial deadzone
+
+    public:
+        static JoystickAxisConditioning Default();
+        static JoystickAxisConditioning Axial(float inner, float outer = 1.0f, ResponseCurve curve = ResponseCurve::Linear);
+        static JoystickAxisConditioning Radial(int32_t pairedAxis, float inner, float outer = 1.0f, ResponseCurve curve = ResponseCurve::Linear);
+    };
+
+    /// <summary>
+    /// Conditions the axes of all joysticks in one batched pass.
+    /// Every axis of every joystick is a lane, the lane inputs, outputs and parameters
+    /// are stored as separate arrays so the pass runs four lanes per SSE instruction.
+    /// Lane j * CPP_GLFW_JOYSTICK_MAX_AXES + a holds axis a of joystick j.
+    /// </summary>
+    class JoystickConditioning
+    {
+    protected:
+        alignas(16) static float s_Input[CPP_GLFW_JOYSTICK_AXIS_LANES];
+        alignas(16) static float s_Paired[CPP_GLFW_JOYSTICK_AXIS_LANES]; //value of the paired axis, gathered before each pass
+        alignas(16) static float s_Output[CPP_GLFW_JOYSTICK_AXIS_LANES]; //also the smoothing state
+        alignas(16) static float s_DeadzoneInner[CPP_GLFW_JOYSTICK_AXIS_LANES];
+        alignas(16) static float s_DeadzoneScale[CPP_GLFW_JOYSTICK_AXIS_LANES]; //1 / (outer - inner)
+        alignas(16) static float s_CurveLinear[CPP_GLFW_JOYSTICK_AXIS_LANES];
+        alignas(16) static float s_CurveQuadratic[CPP_GLFW_JOYSTICK_AXIS_LANES];
+        alignas(16) static float s_CurveCubic[CPP_GLFW_JOYSTICK_AXIS_LANES];
+        alignas(16) static float s_Response[CPP_GLFW_JOYSTICK_AXIS_LANES]; //1 - smoothing
+        static int8_t s_PairedAxis[CPP_GLFW_JOYSTICK_AXIS_LANES];
+        static JoystickAxisConditioning s_Conditioning[CPP_GLFW_JOYSTICK_AXIS_LANES];
+        static bool s_Initialized;
+
+    public: CPP_GLFW_INTERNAL_API
+        static void Init();
+        static void SetConditioning(int32_t jid, int32_t axis, const JoystickAxisConditioning& conditioning);
+        static const JoystickAxisConditioning& GetConditioning(int32_t jid, int32_t axis);
+        static void SetInput(int32_t jid, int32_t axis, float value);
+        static void ResetJoystick(int32_t jid);
+        static const float* GetOutput(int32_t jid);
+        static void Process();
+    };
+}
@@ -0,0 +1,240 @@
+#include "engine/core/Platform.h"
+
+namespace cpp_glfw
+{
+    ////////////////////////////////////// STATIC INIT ///////////////////////////////////////////
+
+    Allocator Memory::s_Allocator = { Memory::DefaultAllocate, Memory::DefaultReallocate, Memory::DefaultDeallocate, nullptr };
+    Memory::Counters Memory::s_Counters[(int32_t)MemoryTag::Count] = {};
+
+
+
+    Allocator Allocator::Default()
+    {
+        Allocator allocator = {};
+        allocator.allocate = Memory::DefaultAllocate;
+        allocator.reallocate = Memory::DefaultReallocate;
+        allocator.deallocate = Memory::DefaultDeallocate;
+        return allocator;
+    }
+
+
+
+    /////////////////////////////////////// PUBLIC API ////////////////////////////////////////
+
+    MemoryStats Memory::GetStats(MemoryTag tag)
+    {
+        const Counters& counters = s_Counters[(int32_t)tag];
+
+        MemoryStats stats = {};
+        stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+        stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+        stats.allocationCount = counters.allocationCount.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /// <summary> Sums every tag, the peak is the sum of the peaks per tag so it can exceed the real peak </summary>
+    MemoryStats Memory::GetTotalStats()
+    {
+        MemoryStats total = {};
+        for (int32_t tag = 0; tag < (int32_t)MemoryTag::Count; tag++)
+        {
+            const MemoryStats stats = GetStats((MemoryTag)tag);
+            total.liveBytes += stats.liveBytes;
+            total.peakBytes += stats.peakBytes;
+            total.allocationCount += stats.allocationCount;
+        }
+        return total;
+    }
+
+
+
+    ////////////////////////////////////// INTERNAL API ///////////////////////////////////////
+
+    /// <summary> Only called by Platform::Init, before anything is allocated through the previous allocator </summary>
+    bool Memory::SetAllocator(const Allocator* allocator)
+    {
+        if (!allocator)
+        {
+            s_Allocator = Allocator::Default();
+            return true;
+        }
+
+        if (!allocator->allocate
+            || !allocator->reallocate
+            || !allocator->deallocate)
+        {
+            CPP_GLFW_ERROR("Invalid allocator, every callback has to be set!");
+            return false;
+        }
+
+        s_Allocator = *allocator;
+        return true;
+    }
+
+    void Memory::ResetStats()
+    {
+        for (Counters& counters : s_Counters)
+        {
+            counters.peakBytes = counters.liveBytes.load();
+            counters.allocationCount = 0;
+        }
+    }
+
+    void* Memory::Allocate(size_t size, MemoryTag tag, size_t alignment)
+    {
+        alignment = std::max(alignment, MinAlignment);
+        const size_t offset = GetHeaderSpace(alignment);
+
+        uint8_t* base = (uint8_t*)s_Allocator.allocate(size + offset, alignment, tag, s_Allocator.user);
+        if (!base)
+        {
+            CPP_GLFW_ERROR("Failed to allocate %zu bytes!", size);
+            return nullptr;
+        }
+
+        Header* header = (Header*)(base + offset) - 1;
+        header->size = size;
+        header->deallocate = s_Allocator.deallocate;
+        header->user = s_Allocator.user;
+        header->alignment = (uint32_t)alignment;
+        header->tag = tag;
+
+        Count(tag, 0, size);
+        return base + offset;
+    }
+
+    void* Memory::Calloc(size_t count, size_t size, MemoryTag tag)
+    {
+        void* block = Allocate(count * size, tag);
+        if (block)
+        {
+            memset(block, 0, count * size);
+        }
+        return block;
+    }
+
+    /// <summary> Keeps the tag and alignment of the block, a null block is allocated like Allocate </summary>
+    void* Memory::Reallocate(void* block, size_t size, MemoryTag tag)
+    {
+        if (!block)
+        {
+            return Allocate(size, tag);
+        }
+
+        const Header header = *((Header*)block - 1);
+        const size_t offset = GetHeaderSpace(header.alignment);
+        uint8_t* base = (uint8_t*)block - offset;
+
+        //larger alignments cannot rely on the allocator keeping the offset and blocks of a previous allocator
+        //cannot be handed to the current one, so both move by hand
+        if (header.alignment > MinAlignment
+            || header.deallocate != s_Allocator.deallocate
+            || header.user != s_Allocator.user)
+        {
+            void* moved = Allocate(size, header.tag, header.alignment);
+            if (moved)
+            {
+                memcpy(moved, block, std::min(size, header.size));
+                Free(block);
+            }
+            return moved;
+        }
+
+        base = (uint8_t*)s_Allocator.reallocate(base, size + offset, header.alignment, header.tag, s_Allocator.user);
+        if (!base)
+        {
+            CPP_GLFW_ERROR("Failed to reallocate %zu bytes!", size);
+            return nullptr;
+        }
+
+        ((Header*)(base + offset) - 1)->size = size;
+
+        Count(header.tag, header.size, size);
+        return base + offset;
+    }
+
+    /// <summary> Returns the block to the allocator it came from, which can differ from the current one for blocks of static containers </summary>
+    void Memory::Free(void* block)
+    {
+        if (!block)
+        {
+            return;
+        }
+
+        const Header header = *((Header*)block - 1);
+        const size_t offset = GetHeaderSpace(header.alignment);
+
+        Count(header.tag, header.size, 0);
+        header.deallocate((uint8_t*)block - offset, header.size + offset, header.alignment, header.tag, header.user);
+    }
+
+
+
+    ///////////////////////////////////////// UTILS ///////////////////////////////////////////
+
+    /// <summary> The header sits right before the block, so it takes whole alignment steps </summary>
+    size_t Memory::GetHeaderSpace(size_t alignment)
+    {
+        return (sizeof(Header) + alignment - 1) / alignment * alignment;
+    }
+
+    void Memory::Count(MemoryTag tag, size_t oldSize, size_t newSize)
+    {
+        Counters& counters = s_Counters[(int32_t)tag];
+
+        if (newSize >= oldSize)
+        {
+            const size_t live = counters.liveBytes.fetch_add(newSize - oldSize, std::memory_order_relaxed) + newSize - oldSize;
+
+            size_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+            while (live > peak
+                && !counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+            {
+            }
+        }
+        else
+        {
+            counters.liveBytes.fetch_sub(oldSize - newSize, std::memory_order_relaxed);
+        }
+
+        if (newSize)
+        {
+            counters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void* Memory::DefaultAllocate(size_t size, size_t alignment, MemoryTag tag, void* user)
+    {
+        if (alignment <= MinAlignment)
+        {
+            return malloc(size);
+        }
+
+#ifdef _WIN32
+        return _aligned_malloc(size, alignment);
+#else
+        return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+    }
+
+    void* Memory::DefaultReallocate(void* block, size_t size, size_t alignment, MemoryTag tag, void* user)
+    {
+        return realloc(block, size);
+    }
+
+    void Memory::DefaultDeallocate(void* block, size_t size, size_t alignment, MemoryTag tag, void* user)
+    {
+        if (alignment <= MinAlignment)
+        {
+            free(block);
+            return;
+        }
+
+#ifdef _WIN32
+        _aligned_free(block);
+#else
+        free(block);
+#endif
+    }
+}
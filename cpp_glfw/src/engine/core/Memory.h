@@ -0,0 +1,162 @@
+#pragma once
+
+#include "engine/core/Base.h"
+
+#include <atomic>
+#include <new>
+
+namespace cpp_glfw
+{
+    enum class MemoryTag
+    {
+        General = 0, //strings and other short lived buffers
+        Window = 1,
+        Monitor = 2,
+        Cursor = 3,
+        Input = 4,
+        Clipboard = 5,
+        Context = 6,
+        Capture = 7, //frame capture and recording
+        Count = 8
+    };
+
+    /// <summary>
+    /// Allocation callbacks passed to Platform::Init, the objects of the library and its internal caches, tables and buffers go through them.
+    /// Excluded are the containers handed out by reference through the public API (names, video modes, window and monitor lists, library names),
+    /// the buffer filled by clipboard providers, the registries of Platform (slot maps, window, monitor and cursor lists, handle maps)
+    /// and the containers owned by the platform backends, those keep the default allocator and are not counted.
+    /// Blocks must be aligned to the requested alignment, reallocate is only called for alignments up to 16.
+    /// Blocks are always returned to the allocator they came from, which has to stay valid until after Platform::Terminate.
+    /// </summary>
+    struct Allocator
+    {
+        void* (*allocate)(size_t size, size_t alignment, MemoryTag tag, void* user);
+        void* (*reallocate)(void* block, size_t size, size_t alignment, MemoryTag tag, void* user);
+        void (*deallocate)(void* block, size_t size, size_t alignment, MemoryTag tag, void* user);
+        void* user;
+
+    public:
+        static Allocator Default();
+    };
+
+    struct MemoryStats
+    {
+        size_t liveBytes;
+        size_t peakBytes;
+        uint64_t allocationCount; //allocations and reallocations since Platform::Init, unchanged across PollEvents once warmed up, see tests/EventAllocationTest.cpp
+    };
+
+    /// <summary>
+    /// Routes the allocations of the library to the allocator set at Platform::Init and counts them per tag.
+    /// Every block has a small header with its size, tag and allocator, so frees and reallocations need none of them.
+    /// </summary>
+    class Memory
+    {
+    protected:
+        struct Header
+        {
+            size_t size;
+            void (*deallocate)(void* block, size_t size, size_t alignment, MemoryTag tag, void* user);
+            void* user;
+            uint32_t alignment;
+            MemoryTag tag;
+        };
+
+        struct Counters
+        {
+            std::atomic<size_t> liveBytes;
+            std::atomic<size_t> peakBytes;
+            std::atomic<uint64_t> allocationCount;
+        };
+
+        static constexpr size_t MinAlignment = 16;
+
+        friend struct Allocator;
+
+    protected:
+        static Allocator s_Allocator;
+        static Counters s_Counters[(int32_t)MemoryTag::Count];
+
+    public: CPP_GLFW_PUBLIC_API
+        static MemoryStats GetStats(MemoryTag tag);
+        static MemoryStats GetTotalStats();
+
+    public: CPP_GLFW_INTERNAL_API
+        static bool SetAllocator(const Allocator* allocator);
+        static void ResetStats();
+
+        static void* Allocate(size_t size, MemoryTag tag, size_t alignment = MinAlignment);
+        static void* Calloc(size_t count, size_t size, MemoryTag tag);
+        static void* Reallocate(void* block, size_t size, MemoryTag tag);
+        static void Free(void* block);
+
+    protected: CPP_GLFW_UTILS
+        static size_t GetHeaderSpace(size_t alignment);
+        static void Count(MemoryTag tag, size_t oldSize, size_t newSize);
+
+        static void* DefaultAllocate(size_t size, size_t alignment, MemoryTag tag, void* user);
+        static void* DefaultReallocate(void* block, size_t size, size_t alignment, MemoryTag tag, void* user);
+        static void DefaultDeallocate(void* block, size_t size, size_t alignment, MemoryTag tag, void* user);
+    };
+
+    /// <summary>
+    /// Standard allocator for containers whose memory should be counted under a tag.
+    /// Containers cannot be handed a null block, so a failure throws std::bad_alloc like the default allocator does.
+    /// Buffers that have to survive a failed allocation use Memory::Allocate directly instead.
+    /// </summary>
+    template<typename T, MemoryTag Tag>
+    struct TaggedAllocator
+    {
+        typedef T value_type;
+
+        template<typename U>
+        struct rebind
+        {
+            typedef TaggedAllocator<U, Tag> other;
+        };
+
+        TaggedAllocator() = default;
+
+        template<typename U>
+        TaggedAllocator(const TaggedAllocator<U, Tag>&) {}
+
+        T* allocate(size_t count)
+        {
+            T* block = (T*)Memory::Allocate(count * sizeof(T), Tag, std::max(alignof(T), (size_t)16));
+            if (!block)
+            {
+                throw std::bad_alloc();
+            }
+            return block;
+        }
+
+        void deallocate(T* block, size_t count)
+        {
+            Memory::Free(block);
+        }
+
+        template<typename U>
+        bool operator==(const TaggedAllocator<U, Tag>&) const { return true; }
+
+        template<typename U>
+        bool operator!=(const TaggedAllocator<U, Tag>&) const { return false; }
+    };
+
+    template<typename T, MemoryTag Tag>
+    using TaggedVector = std::vector<T, TaggedAllocator<T, Tag>>;
+
+    template<MemoryTag Tag>
+    using TaggedString = std::basic_string<char, std::char_traits<char>, TaggedAllocator<char, Tag>>;
+
+    template<typename Key, typename Value, MemoryTag Tag>
+    using TaggedMap = std::unordered_map<Key, Value, std::hash<Key>, std::equal_to<Key>, TaggedAllocator<std::pair<const Key, Value>, Tag>>;
+}
+
+/// <summary>
+/// Makes new and delete of a class and the classes derived from it go through Memory.
+/// New returns nullptr on failure without running the constructor, so every factory checks the result and takes its error path.
+/// </summary>
+#define CPP_GLFW_MEMORY_TAG(tag) \
+    public: \
+        static void* operator new(size_t size) noexcept { return ::cpp_glfw::Memory::Allocate(size, tag); } \
+        static void operator delete(void* block) { ::cpp_glfw::Memory::Free(block); }
@@ -24,24 +24,25 @@ namespace cpp_glfw
         }
     }
 
+    /// <summary> Sorts video modes by color depth, area, width and refresh rate and removes duplicates </summary>
+    void Monitor::SortVideoModes(std::vector<VideoMode>& videoModes)
+    {
+        std::sort(videoModes.begin(), videoModes.end());
+        videoModes.erase(std::unique(videoModes.begin(), videoModes.end()), videoModes.end());
+    }
+
 
 
     ////////////////////////////////////// CONSTRUCTOR ////////////////////////////////////////
 
     Monitor::Monitor()
     {
+        m_Id = Platform::s_MonitorSlots.Insert(this);
     }
 
     Monitor::~Monitor()
     {
-        if (m_VideoModes.size())
-        {
-            for (int32_t i = 0; i < m_VideoModes.size(); i++)
-            {
-                delete m_VideoModes[i];
-            }
-            m_VideoModes.clear();
-        }
+        Platform::s_MonitorSlots.Remove(m_Id);
     }
 
 
@@ -54,19 +55,45 @@ namespace cpp_glfw
     }
 
 
+    /// <summary> Cached until the platform reports a display change </summary>
     void Monitor::GetPosition(int32_t* x, int32_t* y) const
     {
-        return PlatformGetPosition(x, y);
+        if ((m_CachedProperties & MonitorProperty::Position) != MonitorProperty::Position)
+        {
+            PlatformGetPosition(&m_Cache.x, &m_Cache.y);
+            m_CachedProperties = m_CachedProperties | MonitorProperty::Position;
+        }
+
+        if (x) *x = m_Cache.x;
+        if (y) *y = m_Cache.y;
     }
 
+    /// <summary> Cached until the platform reports a display or work area change </summary>
     void Monitor::GetWorkarea(int32_t* x, int32_t* y, int32_t* width, int32_t* height) const
     {
-        return PlatformGetWorkarea(x, y, width, height);
+        if ((m_CachedProperties & MonitorProperty::Workarea) != MonitorProperty::Workarea)
+        {
+            PlatformGetWorkarea(&m_Cache.workareaX, &m_Cache.workareaY, &m_Cache.workareaWidth, &m_Cache.workareaHeight);
+            m_CachedProperties = m_CachedProperties | MonitorProperty::Workarea;
+        }
+
+        if (x) *x = m_Cache.workareaX;
+        if (y) *y = m_Cache.workareaY;
+        if (width) *width = m_Cache.workareaWidth;
+        if (height) *height = m_Cache.workareaHeight;
     }
 
+    /// <summary> Cached until the platform reports a display or DPI change </summary>
     void Monitor::GetContentScale(float* xScale, float* yScale) const
     {
-        return PlatformGetContentScale(xScale, yScale);
+        if ((m_CachedProperties & MonitorProperty::ContentScale) != MonitorProperty::ContentScale)
+        {
+            PlatformGetContentScale(&m_Cache.xScale, &m_Cache.yScale);
+            m_CachedProperties = m_CachedProperties | MonitorProperty::ContentScale;
+        }
+
+        if (xScale) *xScale = m_Cache.xScale;
+        if (yScale) *yScale = m_Cache.yScale;
     }
 
     void Monitor::GetPhysicalSize(int32_t* widthInMillimeters, int32_t* heightInMillimeters) const
@@ -76,7 +103,8 @@ namespace cpp_glfw
     }
 
 
-    const std::vector<VideoMode*>& Monitor::GetVideoModes()
+    /// <summary> The returned modes are loaded once and stay valid for the lifetime of the monitor </summary>
+    const std::vector<VideoMode>& Monitor::GetVideoModes()
     {
         RefreshVideoModes();
 
@@ -111,41 +139,38 @@ namespace cpp_glfw
             return;
         }
 
-        const GammaRamp* currentRamp = GetGammaRamp();
+        SetGamma(GammaSettings::FromGamma(gamma));
+    }
 
-        if (!currentRamp)
+    void Monitor::SetGamma(const GammaSettings& settings)
+    {
+        if (!Gamma::IsValid(settings))
         {
+            CPP_GLFW_ERROR("Invalid gamma settings!");
             return;
         }
 
-        GammaRamp* ramp = new GammaRamp(currentRamp->size);
-
-        for (uint32_t i = 0; i < currentRamp->size; i++)
+        const uint32_t size = GetGammaRampSize();
+        if (!size)
         {
-            //calculate intensity
-            float value = i / (float)(currentRamp->size - 1);
-
-            //apply gamma curve
-            value = powf(value, 1.0f / gamma) * 65535.0f + 0.5f;
-
-            //clamp to value range
-            value = Utils::fminf(value, 65535.0f);
-
-            ramp->red.push_back((uint16_t)value);
-            ramp->green.push_back((uint16_t)value);
-            ramp->blue.push_back((uint16_t)value);
+            return;
         }
 
-        SetGammaRamp(ramp);
+        Gamma::GenerateRamp(settings, size, &m_GeneratedGammaRamp);
 
-        delete ramp;
+        m_TransitionActive = false;
+        ApplyGammaRamp(&m_GeneratedGammaRamp);
     }
 
     const GammaRamp* Monitor::GetGammaRamp()
     {
         m_CurrentGammaRamp.Clear();
 
-        PlatformGetGammaRamp(&m_CurrentGammaRamp);
+        //read through the generated ramp, which SetGamma and transitions overwrite before every use
+        if (PlatformGetGammaRamp(&m_GeneratedGammaRamp))
+        {
+            m_CurrentGammaRamp.Assign(m_GeneratedGammaRamp);
+        }
 
         return &m_CurrentGammaRamp;
     }
@@ -159,18 +184,16 @@ namespace cpp_glfw
             return;
         }
 
-        //make sure we have the original ramp
-        if (!m_OriginalGammaRamp.size
-            && !PlatformGetGammaRamp(&m_OriginalGammaRamp))
-        {
-            return;
-        }
+        m_TransitionActive = false;
 
-        PlatformSetGammaRamp(ramp);
+        m_GeneratedGammaRamp.Assign(*ramp);
+        ApplyGammaRamp(&m_GeneratedGammaRamp);
     }
 
     void Monitor::RestoreOriginalGammaRamp()
     {
+        m_TransitionActive = false;
+
         if (m_OriginalGammaRamp.size)
         {
             PlatformSetGammaRamp(&m_OriginalGammaRamp);
@@ -178,6 +201,62 @@ namespace cpp_glfw
     }
 
 
+    void Monitor::TransitionGamma(const GammaSettings& settings, double duration)
+    {
+        if (!Gamma::IsValid(settings))
+        {
+            CPP_GLFW_ERROR("Invalid gamma settings!");
+            return;
+        }
+
+        const uint32_t size = GetGammaRampSize();
+        if (!size)
+        {
+            return;
+        }
+
+        Gamma::GenerateRamp(settings, size, &m_TransitionTo);
+        BeginGammaTransition(duration);
+    }
+
+    /// <summary> Blends from the current ramp to the given one over duration seconds, advanced by Platform::PollEvents </summary>
+    void Monitor::TransitionGammaRamp(const GammaRamp* ramp, double duration)
+    {
+        if (!ramp
+            || !ramp->IsValid())
+        {
+            CPP_GLFW_ERROR("Invalid gamma ramp!");
+            return;
+        }
+
+        m_TransitionTo.Assign(*ramp);
+        BeginGammaTransition(duration);
+    }
+
+    bool Monitor::IsGammaTransitionActive() const
+    {
+        return m_TransitionActive;
+    }
+
+
+    /// <summary> Returns the parsed EDID of the display, or nullptr when the platform does not provide one </summary>
+    const EdidInfo* Monitor::GetEdid()
+    {
+        if (!m_EdidLoaded)
+        {
+            m_EdidLoaded = true;
+
+            std::vector<uint8_t> data;
+            if (PlatformGetEdid(data))
+            {
+                m_Edid = Edid::Get(data.data(), data.size());
+            }
+        }
+
+        return m_Edid;
+    }
+
+
     Window* Monitor::GetWindow() const
     {
         return m_Window;
@@ -188,26 +267,148 @@ namespace cpp_glfw
         m_Window = window;
     }
 
+    /// <summary> Stable id for referring to the monitor without keeping a pointer, see Platform::GetMonitorById </summary>
+    uint32_t Monitor::GetId() const
+    {
+        return m_Id;
+    }
+
+
+
+    ////////////////////////////////////// INTERNAL API ///////////////////////////////////////
+
+    /// <summary> Called once per PollEvents, blends into a reused ramp so running transitions do not allocate </summary>
+    void Monitor::UpdateGammaTransition()
+    {
+        if (!m_TransitionActive)
+        {
+            return;
+        }
+
+        const double t = (Platform::GetTime() - m_TransitionStart) / m_TransitionDuration;
+
+        if (t >= 1.0)
+        {
+            m_TransitionActive = false;
+            ApplyGammaRamp(&m_TransitionTo);
+            return;
+        }
+
+        Gamma::LerpRamp(m_TransitionFrom, m_TransitionTo, (float)t, &m_GeneratedGammaRamp);
+        ApplyGammaRamp(&m_GeneratedGammaRamp);
+    }
+
+
+
+    /// <summary> Reads the current properties and returns the ones that differ from the previous read </summary>
+    MonitorProperty Monitor::RefreshProperties()
+    {
+        MonitorProperties properties = {};
+        PlatformGetPosition(&properties.x, &properties.y);
+        PlatformGetWorkarea(&properties.workareaX, &properties.workareaY, &properties.workareaWidth, &properties.workareaHeight);
+        PlatformGetContentScale(&properties.xScale, &properties.yScale);
+        PlatformGetVideoMode(&properties.videoMode);
+
+        MonitorProperty changed = MonitorProperty::None;
+
+        if (properties.x != m_Properties.x
+            || properties.y != m_Properties.y)
+        {
+            changed = changed | MonitorProperty::Position;
+        }
+
+        if (properties.workareaX != m_Properties.workareaX
+            || properties.workareaY != m_Properties.workareaY
+            || properties.workareaWidth != m_Properties.workareaWidth
+            || properties.workareaHeight != m_Properties.workareaHeight)
+        {
+            changed = changed | MonitorProperty::Workarea;
+        }
+
+        if (properties.xScale != m_Properties.xScale
+            || properties.yScale != m_Properties.yScale)
+        {
+            changed = changed | MonitorProperty::ContentScale;
+        }
+
+        if (!(properties.videoMode == m_Properties.videoMode))
+        {
+            changed = changed | MonitorProperty::VideoMode;
+        }
+
+        m_Properties = properties;
+
+        //the values were just read, so they also refresh the getter cache
+        m_Cache = properties;
+        m_CachedProperties = MonitorProperty::Position | MonitorProperty::Workarea | MonitorProperty::ContentScale;
+
+        return changed;
+    }
+
+    void Monitor::InvalidateCache(MonitorProperty properties)
+    {
+        m_CachedProperties = m_CachedProperties & ~properties;
+    }
+
 
 
     ///////////////////////////////////////// UTILS ///////////////////////////////////////////
 
-    bool Monitor::RefreshVideoModes()
+    bool Monitor::ApplyGammaRamp(const MonitorGammaRamp* ramp)
     {
-        if (m_VideoModes.size())
+        if (!ramp
+            || !ramp->IsValid())
         {
-            //since video modes will not change at runtime, this method's purpose is only for lazy loading
-            return true;
+            CPP_GLFW_ERROR("Invalid gamma ramp!");
+            return false;
         }
 
-        //clear existing video modes
+        //make sure we have the original ramp
+        if (!m_OriginalGammaRamp.size
+            && !PlatformGetGammaRamp(&m_OriginalGammaRamp))
+        {
+            return false;
+        }
+
+        PlatformSetGammaRamp(ramp);
+        return true;
+    }
+
+    /// <summary> Blends from the ramp on screen to m_TransitionTo, a transition that is still running continues from where it is </summary>
+    void Monitor::BeginGammaTransition(double duration)
+    {
+        if (duration <= 0.0
+            || !PlatformGetGammaRamp(&m_TransitionFrom)
+            || m_TransitionFrom.size != m_TransitionTo.size)
+        {
+            m_TransitionActive = false;
+            ApplyGammaRamp(&m_TransitionTo);
+            return;
+        }
+
+        m_TransitionStart = Platform::GetTime();
+        m_TransitionDuration = duration;
+        m_TransitionActive = true;
+    }
+
+    /// <summary> The ramp size is fixed per monitor, so it is taken from the original ramp instead of reading the current one </summary>
+    uint32_t Monitor::GetGammaRampSize()
+    {
+        if (!m_OriginalGammaRamp.size
+            && !PlatformGetGammaRamp(&m_OriginalGammaRamp))
+        {
+            return 0;
+        }
+
+        return m_OriginalGammaRamp.size;
+    }
+
+    bool Monitor::RefreshVideoModes()
+    {
         if (m_VideoModes.size())
         {
-            for (int32_t i = 0; i < m_VideoModes.size(); i++)
-            {
-                delete m_VideoModes[i];
-            }
-            m_VideoModes.clear();
+            //since video modes will not change at runtime, this method's purpose is only for lazy loading
+            return true;
         }
 
         PlatformGetVideoModes(m_VideoModes);
@@ -217,10 +418,60 @@ namespace cpp_glfw
             return false;
         }
 
-        std::sort(m_VideoModes.begin(), m_VideoModes.end(), [](VideoMode* a, VideoMode* b) { return *a < *b; });
+        SortVideoModes(m_VideoModes);
+        BuildVideoModeIndex();
         return true;
     }
 
+    /// <summary> Groups the sorted modes by color depth, then by size, so closest mode queries can binary search </summary>
+    void Monitor::BuildVideoModeIndex()
+    {
+        m_VideoModeBuckets.clear();
+        m_VideoModeSizes.clear();
+
+        for (uint32_t i = 0; i < m_VideoModes.size(); i++)
+        {
+            const VideoMode& videoMode = m_VideoModes[i];
+
+            if (m_VideoModeBuckets.empty()
+                || m_VideoModeBuckets.back().redBits != videoMode.redBits
+                || m_VideoModeBuckets.back().greenBits != videoMode.greenBits
+                || m_VideoModeBuckets.back().blueBits != videoMode.blueBits)
+            {
+                m_VideoModeBuckets.push_back({ videoMode.redBits, videoMode.greenBits, videoMode.blueBits, (uint32_t)m_VideoModeSizes.size(), 0 });
+            }
+
+            VideoModeBucket& bucket = m_VideoModeBuckets.back();
+
+            //within a color depth modes are sorted by area and width, so modes of one size are adjacent
+            if (bucket.sizeCount
+                && m_VideoModeSizes.back().width == videoMode.width
+                && m_VideoModeSizes.back().height == videoMode.height)
+            {
+                m_VideoModeSizes.back().modeCount++;
+                continue;
+            }
+
+            m_VideoModeSizes.push_back({ videoMode.width, videoMode.height, i, 1 });
+            bucket.sizeCount++;
+        }
+
+        for (const VideoModeBucket& bucket : m_VideoModeBuckets)
+        {
+            std::sort(
+                m_VideoModeSizes.begin() + bucket.firstSize,
+                m_VideoModeSizes.begin() + bucket.firstSize + bucket.sizeCount,
+                [](const VideoModeSize& a, const VideoModeSize& b)
+                {
+                    return a.width != b.width ? a.width < b.width : a.height < b.height;
+                });
+        }
+    }
+
+    /// <summary>
+    /// Picks the mode with the least color difference, then the least size difference, then the least refresh rate difference.
+    /// Ties go to the mode that comes first in the sorted mode list.
+    /// </summary>
     const VideoMode* Monitor::GetClosestVideoMode(const VideoMode* videoMode)
     {
         if (!RefreshVideoModes())
@@ -228,48 +479,113 @@ namespace cpp_glfw
             return nullptr;
         }
 
+        //all modes of a bucket share their color bits, so the color difference is computed per bucket
+        auto getColorDiff = [videoMode](const VideoModeBucket& bucket)
+        {
+            uint32_t colorDiff = 0;
+            if (videoMode->redBits != -1) colorDiff += abs(bucket.redBits - videoMode->redBits);
+            if (videoMode->greenBits != -1) colorDiff += abs(bucket.greenBits - videoMode->greenBits);
+            if (videoMode->blueBits != -1) colorDiff += abs(bucket.blueBits - videoMode->blueBits);
+            return colorDiff;
+        };
+
         uint32_t leastColorDiff = UINT_MAX;
-        uint32_t leastSizeDiff = UINT_MAX;
+        for (const VideoModeBucket& bucket : m_VideoModeBuckets)
+        {
+            leastColorDiff = std::min(leastColorDiff, getColorDiff(bucket));
+        }
+
+        uint64_t leastSizeDiff = UINT64_MAX;
         uint32_t leastRefreshRateDiff = UINT_MAX;
-        VideoMode* closestVideoMode = nullptr;
+        int32_t closestIndex = -1;
 
-        for (int i = 0; i < m_VideoModes.size(); i++)
+        for (const VideoModeBucket& bucket : m_VideoModeBuckets)
         {
-            VideoMode* currentVideoMode = m_VideoModes[i];
+            if (getColorDiff(bucket) == leastColorDiff)
+            {
+                FindClosestVideoModeInBucket(bucket, videoMode, &leastSizeDiff, &leastRefreshRateDiff, &closestIndex);
+            }
+        }
 
-            uint32_t colorDiff = 0;
-            if (videoMode->redBits != -1)
+        return closestIndex != -1 ? &m_VideoModes[closestIndex] : nullptr;
+    }
+
+    void Monitor::FindClosestVideoModeInBucket(const VideoModeBucket& bucket, const VideoMode* videoMode, uint64_t* leastSizeDiff, uint32_t* leastRefreshRateDiff, int32_t* closestIndex) const
+    {
+        const VideoModeSize* first = &m_VideoModeSizes[bucket.firstSize];
+        const VideoModeSize* last = first + bucket.sizeCount;
+
+        //sizes are sorted by width, start at the requested width and walk outwards
+        //until the width difference alone exceeds the best size difference found so far
+        const VideoModeSize* start = std::lower_bound(first, last, videoMode->width,
+            [](const VideoModeSize& size, int32_t width) { return size.width < width; });
+
+        auto consider = [&](const VideoModeSize& size)
+        {
+            const int64_t widthDiff = size.width - videoMode->width;
+            const int64_t heightDiff = size.height - videoMode->height;
+            const uint64_t sizeDiff = (uint64_t)(widthDiff * widthDiff + heightDiff * heightDiff);
+
+            if (sizeDiff > *leastSizeDiff)
             {
-                colorDiff += abs(currentVideoMode->redBits - videoMode->redBits);
+                return;
             }
-            if (videoMode->greenBits != -1)
+
+            //modes of this size are sorted by refresh rate
+            const VideoMode* modes = &m_VideoModes[size.firstMode];
+            uint32_t index;
+
+            if (videoMode->refreshRate == -1)
             {
-                colorDiff += abs(currentVideoMode->greenBits - videoMode->greenBits);
+                //prefer the highest refresh rate
+                index = size.modeCount - 1;
             }
-            if (videoMode->blueBits != -1)
+            else
             {
-                colorDiff += abs(currentVideoMode->blueBits - videoMode->blueBits);
+                index = (uint32_t)(std::lower_bound(modes, modes + size.modeCount, videoMode->refreshRate,
+                    [](const VideoMode& mode, int32_t refreshRate) { return mode.refreshRate < refreshRate; }) - modes);
+
+                if (index == size.modeCount
+                    || (index > 0 && videoMode->refreshRate - modes[index - 1].refreshRate <= modes[index].refreshRate - videoMode->refreshRate))
+                {
+                    index--;
+                }
             }
 
-            int32_t widthDiff = currentVideoMode->width - videoMode->width;
-            int32_t heightDiff = currentVideoMode->height - videoMode->height;
-            uint32_t sizeDiff = abs(widthDiff * widthDiff + heightDiff * heightDiff);
+            const uint32_t refreshRateDiff = videoMode->refreshRate != -1
+                ? abs(modes[index].refreshRate - videoMode->refreshRate)
+                : UINT_MAX - modes[index].refreshRate;
+
+            const int32_t modeIndex = (int32_t)(size.firstMode + index);
 
-            uint32_t refreshRateDiff = videoMode->refreshRate != -1
-                ? abs(currentVideoMode->refreshRate - videoMode->refreshRate)
-                : UINT_MAX - currentVideoMode->refreshRate;
+            if (sizeDiff < *leastSizeDiff
+                || refreshRateDiff < *leastRefreshRateDiff
+                || (refreshRateDiff == *leastRefreshRateDiff && modeIndex < *closestIndex))
+            {
+                *leastSizeDiff = sizeDiff;
+                *leastRefreshRateDiff = refreshRateDiff;
+                *closestIndex = modeIndex;
+            }
+        };
 
-            if ((colorDiff < leastColorDiff)
-                || (colorDiff == leastColorDiff && sizeDiff < leastSizeDiff)
-                || (colorDiff == leastColorDiff && sizeDiff == leastSizeDiff && refreshRateDiff < leastRefreshRateDiff))
+        for (const VideoModeSize* size = start; size < last; size++)
+        {
+            const int64_t widthDiff = size->width - videoMode->width;
+            if ((uint64_t)(widthDiff * widthDiff) > *leastSizeDiff)
             {
-                closestVideoMode = currentVideoMode;
-                leastColorDiff = colorDiff;
-                leastSizeDiff = sizeDiff;
-                leastRefreshRateDiff = refreshRateDiff;
+                break;
             }
+            consider(*size);
         }
 
-        return closestVideoMode;
+        for (const VideoModeSize* size = start; size > first; size--)
+        {
+            const int64_t widthDiff = size[-1].width - videoMode->width;
+            if ((uint64_t)(widthDiff * widthDiff) > *leastSizeDiff)
+            {
+                break;
+            }
+            consider(size[-1]);
+        }
     }
 }
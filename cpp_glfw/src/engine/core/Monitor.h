@@ -1,11 +1,24 @@
 #pragma once
 
 #include "engine/core/Base.h"
+#include "engine/core/Gamma.h"
+#include "engine/core/Edid.h"
 
 namespace cpp_glfw
 {
     class Window;
 
+    enum class MonitorProperty
+    {
+        None = 0,
+        Position = 1 << 0,
+        Workarea = 1 << 1,
+        ContentScale = 1 << 2,
+        VideoMode = 1 << 3,
+        Primary = 1 << 4
+    };
+    FLAG_OPERATORS(MonitorProperty)
+
     struct VideoMode
     {
         int32_t width;
@@ -15,7 +28,7 @@ namespace cpp_glfw
         int32_t blueBits;
         int32_t refreshRate;
 
-        bool operator==(const VideoMode& other)
+        bool operator==(const VideoMode& other) const
         {
             return width == other.width
                 && height == other.height
@@ -65,16 +78,17 @@ namespace cpp_glfw
         }
     };
 
-    struct GammaRamp
+    template<typename Allocator>
+    struct BasicGammaRamp
     {
-        std::vector<uint16_t> red;
-        std::vector<uint16_t> green;
-        std::vector<uint16_t> blue;
+        std::vector<uint16_t, Allocator> red;
+        std::vector<uint16_t, Allocator> green;
+        std::vector<uint16_t, Allocator> blue;
         uint32_t size;
 
-        GammaRamp() = default;
+        BasicGammaRamp() = default;
 
-        GammaRamp(uint32_t size)
+        BasicGammaRamp(uint32_t size)
         {
             red.reserve(size);
             green.reserve(size);
@@ -82,6 +96,15 @@ namespace cpp_glfw
             this->size = size;
         }
 
+        /// <summary> Sets the size without releasing capacity, so refilling a ramp of the same size does not allocate </summary>
+        void Resize(uint32_t size)
+        {
+            red.resize(size);
+            green.resize(size);
+            blue.resize(size);
+            this->size = size;
+        }
+
         void Clear()
         {
             red.clear();
@@ -90,7 +113,17 @@ namespace cpp_glfw
             size = 0;
         }
 
-        bool IsValid()
+        /// <summary> Copies a ramp of any allocator, reusing the capacity of this one </summary>
+        template<typename OtherAllocator>
+        void Assign(const BasicGammaRamp<OtherAllocator>& other)
+        {
+            red.assign(other.red.begin(), other.red.end());
+            green.assign(other.green.begin(), other.green.end());
+            blue.assign(other.blue.begin(), other.blue.end());
+            size = other.size;
+        }
+
+        bool IsValid() const
         {
             return size > 0
                 && red.size() == size
@@ -99,24 +132,86 @@ namespace cpp_glfw
         }
     };
 
+    struct GammaRamp : BasicGammaRamp<std::allocator<uint16_t>>
+    {
+        using BasicGammaRamp<std::allocator<uint16_t>>::BasicGammaRamp;
+    };
+
+    /// <summary> Ramps kept by a monitor, counted under MemoryTag::Monitor while ramps of the application keep the default allocator </summary>
+    struct MonitorGammaRamp : BasicGammaRamp<TaggedAllocator<uint16_t, MemoryTag::Monitor>>
+    {
+        using BasicGammaRamp<TaggedAllocator<uint16_t, MemoryTag::Monitor>>::BasicGammaRamp;
+    };
+
     class Monitor
     {
+        CPP_GLFW_MEMORY_TAG(MemoryTag::Monitor)
+
     protected:
         std::string m_Name = {};
 
         int32_t m_WidthInMillimeters = 0;
         int32_t m_HeightInMillimeters = 0;
 
+        struct VideoModeBucket
+        {
+            int32_t redBits;
+            int32_t greenBits;
+            int32_t blueBits;
+            uint32_t firstSize;
+            uint32_t sizeCount;
+        };
+
+        struct VideoModeSize
+        {
+            int32_t width;
+            int32_t height;
+            uint32_t firstMode; //modes of one size are contiguous and sorted by refresh rate
+            uint32_t modeCount;
+        };
+
+        //last known values, compared on display changes to report only what changed
+        struct MonitorProperties
+        {
+            int32_t x;
+            int32_t y;
+            int32_t workareaX;
+            int32_t workareaY;
+            int32_t workareaWidth;
+            int32_t workareaHeight;
+            float xScale;
+            float yScale;
+            VideoMode videoMode;
+        } m_Properties = {};
+
+        //values returned by the geometry getters, read from the platform only after being invalidated
+        mutable MonitorProperties m_Cache = {};
+        mutable MonitorProperty m_CachedProperties = MonitorProperty::None;
+
         VideoMode m_CurrentVideoMode = {};
-        std::vector<VideoMode*> m_VideoModes = {};
+        std::vector<VideoMode> m_VideoModes = {}; //sorted and without duplicates
+        std::vector<VideoModeBucket> m_VideoModeBuckets = {}; //one per color depth, in m_VideoModes order
+        std::vector<VideoModeSize> m_VideoModeSizes = {}; //sizes of each bucket, sorted by width then height
 
-        GammaRamp m_OriginalGammaRamp = {};
-        GammaRamp m_CurrentGammaRamp = {};
+        MonitorGammaRamp m_OriginalGammaRamp = {};
+        GammaRamp m_CurrentGammaRamp = {}; //returned by GetGammaRamp
+        MonitorGammaRamp m_GeneratedGammaRamp = {}; //reused by SetGamma, SetGammaRamp and transitions
+
+        MonitorGammaRamp m_TransitionFrom = {};
+        MonitorGammaRamp m_TransitionTo = {};
+        double m_TransitionStart = 0.0;
+        double m_TransitionDuration = 0.0;
+        bool m_TransitionActive = false;
+
+        const EdidInfo* m_Edid = nullptr; //owned by the Edid cache
+        bool m_EdidLoaded = false;
 
         Window* m_Window = nullptr;
+        uint32_t m_Id = 0; //slot in Platform::s_MonitorSlots
 
     protected: CPP_GLFW_UTILS
         static void SplitBPP(int32_t bpp, int32_t* red, int32_t* green, int32_t* blue);
+        static void SortVideoModes(std::vector<VideoMode>& videoModes);
 
     protected:
         Monitor();
@@ -132,34 +227,55 @@ namespace cpp_glfw
         void GetContentScale(float* xScale, float* yScale) const;
         void GetPhysicalSize(int32_t* widthInMillimeters, int32_t* heightInMillimeters) const;
 
-        const std::vector<VideoMode*>& GetVideoModes();
+        const std::vector<VideoMode>& GetVideoModes();
         VideoMode* GetVideoMode();
         void SetVideoMode(const VideoMode* videoMode);
         void RestoreVideoMode();
 
         void SetGamma(float gamma);
+        void SetGamma(const GammaSettings& settings);
         const GammaRamp* GetGammaRamp();
         void SetGammaRamp(GammaRamp* ramp);
         void RestoreOriginalGammaRamp();
 
+        void TransitionGamma(const GammaSettings& settings, double duration);
+        void TransitionGammaRamp(const GammaRamp* ramp, double duration);
+        bool IsGammaTransitionActive() const;
+
+        const EdidInfo* GetEdid();
+
         Window* GetWindow() const;
         void SetWindow(Window* window);
 
+        uint32_t GetId() const;
+
+    public: CPP_GLFW_INTERNAL_API
+        void UpdateGammaTransition();
+        MonitorProperty RefreshProperties();
+        void InvalidateCache(MonitorProperty properties);
+
     protected: CPP_GLFW_UTILS
+        bool ApplyGammaRamp(const MonitorGammaRamp* ramp);
+        void BeginGammaTransition(double duration);
+        uint32_t GetGammaRampSize();
         bool RefreshVideoModes();
+        void BuildVideoModeIndex();
         const VideoMode* GetClosestVideoMode(const VideoMode* videoMode);
+        void FindClosestVideoModeInBucket(const VideoModeBucket& bucket, const VideoMode* videoMode, uint64_t* leastSizeDiff, uint32_t* leastRefreshRateDiff, int32_t* closestIndex) const;
 
     private: CPP_GLFW_PLATFORM_API
         virtual void PlatformGetPosition(int32_t* x, int32_t* y) const = 0;
         virtual void PlatformGetWorkarea(int32_t* x, int32_t* y, int32_t* width, int32_t* height) const = 0;
         virtual void PlatformGetContentScale(float* xScale, float* yScale) const = 0;
 
-        virtual void PlatformGetVideoModes(std::vector<VideoMode*>& videoModes) = 0;
+        virtual void PlatformGetVideoModes(std::vector<VideoMode>& videoModes) = 0;
         virtual void PlatformGetVideoMode(VideoMode* videoMode) = 0;
         virtual void PlatformSetVideoMode(const VideoMode* videoMode) = 0;
         virtual void PlatformRestoreVideoMode() = 0;
 
-        virtual bool PlatformGetGammaRamp(GammaRamp* ramp) = 0;
-        virtual void PlatformSetGammaRamp(const GammaRamp* ramp) = 0;
+        virtual bool PlatformGetGammaRamp(MonitorGammaRamp* ramp) = 0;
+        virtual void PlatformSetGammaRamp(const MonitorGammaRamp* ramp) = 0;
+
+        virtual bool PlatformGetEdid(std::vector<uint8_t>& data) = 0;
     };
 }
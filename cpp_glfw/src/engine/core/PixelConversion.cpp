@@ -0,0 +1,292 @@
+#include "engine/core/Platform.h"
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #define CPP_GLFW_TARGET_AVX2
+#else
+    #include <cpuid.h>
+    #define CPP_GLFW_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace cpp_glfw
+{
+    ////////////////////////////////////// STATIC INIT ///////////////////////////////////////////
+
+    SimdLevel PixelConversion::s_SupportedLevel = PixelConversion::DetectSimdLevel();
+    SimdLevel PixelConversion::s_Level = PixelConversion::s_SupportedLevel;
+
+
+
+    ////////////////////////////////////// INTERNAL API ///////////////////////////////////////
+
+    /// <summary>
+    /// Swaps the red and blue channels, which converts RGBA to BGRA and back.
+    /// With premultiply the color channels are also scaled by alpha, rounded to nearest. Source and target may be the same buffer.
+    /// </summary>
+    void PixelConversion::Swizzle(const uint8_t* source, int32_t sourceStride, uint8_t* target, int32_t targetStride, int32_t width, int32_t height, bool premultiply)
+    {
+        for (int32_t y = 0; y < height; y++)
+        {
+            const uint8_t* sourceRow = source + (size_t)sourceStride * y;
+            uint8_t* targetRow = target + (size_t)targetStride * y;
+
+            switch (s_Level)
+            {
+                case SimdLevel::AVX2: SwizzleRowAVX2(sourceRow, targetRow, width, premultiply); break;
+                case SimdLevel::SSE2: SwizzleRowSSE2(sourceRow, targetRow, width, premultiply); break;
+                default: SwizzleRowScalar(sourceRow, targetRow, width, premultiply); break;
+            }
+        }
+    }
+
+    /// <summary> Writes a 1 bit AND mask, most significant bit first, set where alpha is below 128. Padding bits are cleared </summary>
+    void PixelConversion::GenerateMask(const uint8_t* source, int32_t sourceStride, uint8_t* mask, int32_t maskStride, int32_t width, int32_t height)
+    {
+        const int32_t rowBytes = (width + 7) / 8;
+
+        for (int32_t y = 0; y < height; y++)
+        {
+            uint8_t* maskRow = mask + (size_t)maskStride * y;
+            memset(maskRow + rowBytes, 0, maskStride - rowBytes);
+
+            if (s_Level >= SimdLevel::SSE2)
+            {
+                MaskRowSSE2(source + (size_t)sourceStride * y, maskRow, width);
+            }
+            else
+            {
+                MaskRowScalar(source + (size_t)sourceStride * y, maskRow, width);
+            }
+        }
+    }
+
+    SimdLevel PixelConversion::GetSimdLevel()
+    {
+        return s_Level;
+    }
+
+    /// <summary> Restricts the kernels to the given level, to compare them. Levels the CPU does not support are clamped </summary>
+    void PixelConversion::SetSimdLevel(SimdLevel level)
+    {
+        s_Level = std::min(level, s_SupportedLevel);
+    }
+
+
+
+    ///////////////////////////////////////// UTILS ///////////////////////////////////////////
+
+    SimdLevel PixelConversion::DetectSimdLevel()
+    {
+        uint32_t info[4] = {};
+
+#if defined(_MSC_VER)
+        __cpuidex((int*)info, 0, 0);
+        const uint32_t maxLeaf = info[0];
+        __cpuidex((int*)info, 1, 0);
+#else
+        const uint32_t maxLeaf = __get_cpuid_max(0, nullptr);
+        __cpuid_count(1, 0, info[0], info[1], info[2], info[3]);
+#endif
+
+        //x64 always has SSE2, AVX2 also needs the OS to save the ymm registers
+        const bool osxsave = (info[2] & (1u << 27)) != 0;
+        const bool avx = (info[2] & (1u << 28)) != 0;
+
+        if (maxLeaf < 7
+            || !osxsave
+            || !avx)
+        {
+            return SimdLevel::SSE2;
+        }
+
+#if defined(_MSC_VER)
+        const uint64_t xcr0 = _xgetbv(0);
+        __cpuidex((int*)info, 7, 0);
+#else
+        uint32_t xcr0Low, xcr0High;
+        __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+        const uint64_t xcr0 = ((uint64_t)xcr0High << 32) | xcr0Low;
+        __cpuid_count(7, 0, info[0], info[1], info[2], info[3]);
+#endif
+
+        if ((xcr0 & 0x6) == 0x6
+            && (info[1] & (1u << 5)))
+        {
+            return SimdLevel::AVX2;
+        }
+
+        return SimdLevel::SSE2;
+    }
+
+    /// <summary> c * a / 255 rounded to nearest, exact for all 8 bit inputs </summary>
+    void PixelConversion::SwizzleRowScalar(const uint8_t* source, uint8_t* target, int32_t width, bool premultiply)
+    {
+        for (int32_t x = 0; x < width; x++)
+        {
+            const uint8_t r = source[0];
+            const uint8_t g = source[1];
+            const uint8_t b = source[2];
+            const uint8_t a = source[3];
+
+            if (premultiply)
+            {
+                const uint32_t pr = r * a + 128;
+                const uint32_t pg = g * a + 128;
+                const uint32_t pb = b * a + 128;
+
+                target[0] = (uint8_t)((pb + (pb >> 8)) >> 8);
+                target[1] = (uint8_t)((pg + (pg >> 8)) >> 8);
+                target[2] = (uint8_t)((pr + (pr >> 8)) >> 8);
+            }
+            else
+            {
+                target[0] = b;
+                target[1] = g;
+                target[2] = r;
+            }
+            target[3] = a;
+
+            source += 4;
+            target += 4;
+        }
+    }
+
+    void PixelConversion::SwizzleRowSSE2(const uint8_t* source, uint8_t* target, int32_t width, bool premultiply)
+    {
+        const __m128i alphaGreen = _mm_set1_epi32((int32_t)0xff00ff00);
+        const __m128i low = _mm_set1_epi32(0xff);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i bias = _mm_set1_epi16(128);
+        const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+
+        int32_t x = 0;
+        for (; x + 4 <= width; x += 4)
+        {
+            const __m128i pixels = _mm_loadu_si128((const __m128i*)(source + x * 4));
+
+            //without pshufb the channels are swapped with shifts inside each 32 bit pixel
+            __m128i swapped = _mm_or_si128(_mm_and_si128(pixels, alphaGreen),
+                _mm_or_si128(_mm_and_si128(_mm_srli_epi32(pixels, 16), low), _mm_slli_epi32(_mm_and_si128(pixels, low), 16)));
+
+            if (premultiply)
+            {
+                __m128i lo = _mm_unpacklo_epi8(swapped, zero);
+                __m128i hi = _mm_unpacklo_epi8(_mm_srli_si128(swapped, 8), zero);
+
+                const __m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+                const __m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+                //alpha lanes are multiplied by 255 instead, which the division turns back into alpha
+                const __m128i factorLo = _mm_or_si128(_mm_andnot_si128(alphaLanes, alphaLo), _mm_and_si128(alphaLanes, _mm_set1_epi16(255)));
+                const __m128i factorHi = _mm_or_si128(_mm_andnot_si128(alphaLanes, alphaHi), _mm_and_si128(alphaLanes, _mm_set1_epi16(255)));
+
+                lo = _mm_add_epi16(_mm_mullo_epi16(lo, factorLo), bias);
+                hi = _mm_add_epi16(_mm_mullo_epi16(hi, factorHi), bias);
+                lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+                hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+                swapped = _mm_packus_epi16(lo, hi);
+            }
+
+            _mm_storeu_si128((__m128i*)(target + x * 4), swapped);
+        }
+
+        SwizzleRowScalar(source + x * 4, target + x * 4, width - x, premultiply);
+    }
+
+    CPP_GLFW_TARGET_AVX2 void PixelConversion::SwizzleRowAVX2(const uint8_t* source, uint8_t* target, int32_t width, bool premultiply)
+    {
+        const __m256i swap = _mm256_setr_epi8(
+            2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+            2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+        //broadcasts the alpha byte of each pixel to its three color lanes, 0x80 zeroes the alpha lane so it is kept below
+        const __m256i broadcastLo = _mm256_setr_epi8(
+            3, -128, 3, -128, 3, -128, -128, -128, 7, -128, 7, -128, 7, -128, -128, -128,
+            3, -128, 3, -128, 3, -128, -128, -128, 7, -128, 7, -128, 7, -128, -128, -128);
+        const __m256i broadcastHi = _mm256_setr_epi8(
+            11, -128, 11, -128, 11, -128, -128, -128, 15, -128, 15, -128, 15, -128, -128, -128,
+            11, -128, 11, -128, 11, -128, -128, -128, 15, -128, 15, -128, 15, -128, -128, -128);
+        const __m256i alphaLanes = _mm256_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i bias = _mm256_set1_epi16(128);
+
+        int32_t x = 0;
+        for (; x + 8 <= width; x += 8)
+        {
+            __m256i pixels = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(source + x * 4)), swap);
+
+            if (premultiply)
+            {
+                //unpack and pack both work per 128 bit lane, so the pixel order survives the round trip
+                __m256i lo = _mm256_unpacklo_epi8(pixels, zero);
+                __m256i hi = _mm256_unpackhi_epi8(pixels, zero);
+
+                const __m256i factorLo = _mm256_or_si256(_mm256_shuffle_epi8(pixels, broadcastLo), alphaLanes);
+                const __m256i factorHi = _mm256_or_si256(_mm256_shuffle_epi8(pixels, broadcastHi), alphaLanes);
+
+                lo = _mm256_add_epi16(_mm256_mullo_epi16(lo, factorLo), bias);
+                hi = _mm256_add_epi16(_mm256_mullo_epi16(hi, factorHi), bias);
+                lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8);
+                hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+
+                pixels = _mm256_packus_epi16(lo, hi);
+            }
+
+            _mm256_storeu_si256((__m256i*)(target + x * 4), pixels);
+        }
+
+        SwizzleRowSSE2(source + x * 4, target + x * 4, width - x, premultiply);
+    }
+
+    void PixelConversion::MaskRowScalar(const uint8_t* source, uint8_t* mask, int32_t width)
+    {
+        for (int32_t x = 0; x < width; x += 8)
+        {
+            uint8_t bits = 0;
+            const int32_t count = std::min(width - x, 8);
+
+            for (int32_t i = 0; i < count; i++)
+            {
+                if (source[(x + i) * 4 + 3] < 128)
+                {
+                    bits |= 0x80 >> i;
+                }
+            }
+
+            mask[x / 8] = bits;
+        }
+    }
+
+    void PixelConversion::MaskRowSSE2(const uint8_t* source, uint8_t* mask, int32_t width)
+    {
+        int32_t x = 0;
+        for (; x + 16 <= width; x += 16)
+        {
+            const __m128i* pixels = (const __m128i*)(source + x * 4);
+
+            //move each alpha to the bottom of its pixel and narrow to one byte per pixel
+            const __m128i a0 = _mm_srli_epi32(_mm_loadu_si128(pixels + 0), 24);
+            const __m128i a1 = _mm_srli_epi32(_mm_loadu_si128(pixels + 1), 24);
+            const __m128i a2 = _mm_srli_epi32(_mm_loadu_si128(pixels + 2), 24);
+            const __m128i a3 = _mm_srli_epi32(_mm_loadu_si128(pixels + 3), 24);
+            const __m128i alpha = _mm_packus_epi16(_mm_packs_epi32(a0, a1), _mm_packs_epi32(a2, a3));
+
+            //the sign bit of each byte is set for opaque pixels, the mask wants the transparent ones
+            const uint32_t opaque = (uint32_t)_mm_movemask_epi8(alpha);
+
+            //movemask puts the first pixel in the lowest bit, the mask in the highest one
+            mask[x / 8] = ReverseBits((uint8_t)~opaque);
+            mask[x / 8 + 1] = ReverseBits((uint8_t)~(opaque >> 8));
+        }
+
+        MaskRowScalar(source + x * 4, mask + x / 8, width - x);
+    }
+
+    uint8_t PixelConversion::ReverseBits(uint8_t value)
+    {
+        value = (uint8_t)(((value & 0xf0) >> 4) | ((value & 0x0f) << 4));
+        value = (uint8_t)(((value & 0xcc) >> 2) | ((value & 0x33) << 2));
+        return (uint8_t)(((value & 0xaa) >> 1) | ((value & 0x55) << 1));
+    }
+}
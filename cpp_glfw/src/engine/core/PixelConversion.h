@@ -0,0 +1,45 @@
+#pragma once
+
+#include "engine/core/Base.h"
+
+#include <immintrin.h>
+
+namespace cpp_glfw
+{
+    enum class SimdLevel
+    {
+        Scalar = 0,
+        SSE2 = 1,
+        AVX2 = 2
+    };
+
+    /// <summary>
+    /// Pixel format conversions shared by the icon and cursor code of every backend.
+    /// Each kernel has a scalar reference and vector versions picked once from the CPU features, all of them give identical results.
+    /// Strides are in bytes, so padded rows of the source or target are skipped.
+    /// </summary>
+    class PixelConversion
+    {
+    protected:
+        static SimdLevel s_SupportedLevel;
+        static SimdLevel s_Level;
+
+    public: CPP_GLFW_INTERNAL_API
+        static void Swizzle(const uint8_t* source, int32_t sourceStride, uint8_t* target, int32_t targetStride, int32_t width, int32_t height, bool premultiply);
+        static void GenerateMask(const uint8_t* source, int32_t sourceStride, uint8_t* mask, int32_t maskStride, int32_t width, int32_t height);
+
+        static SimdLevel GetSimdLevel();
+        static void SetSimdLevel(SimdLevel level);
+
+    protected: CPP_GLFW_UTILS
+        static SimdLevel DetectSimdLevel();
+
+        static void SwizzleRowScalar(const uint8_t* source, uint8_t* target, int32_t width, bool premultiply);
+        static void SwizzleRowSSE2(const uint8_t* source, uint8_t* target, int32_t width, bool premultiply);
+        static void SwizzleRowAVX2(const uint8_t* source, uint8_t* target, int32_t width, bool premultiply);
+
+        static void MaskRowScalar(const uint8_t* source, uint8_t* mask, int32_t width);
+        static void MaskRowSSE2(const uint8_t* source, uint8_t* mask, int32_t width);
+        static uint8_t ReverseBits(uint8_t value);
+    };
+}
@@ -8,9 +8,15 @@ namespace cpp_glfw
     std::vector<Window*> Platform::s_Windows = {};
     std::vector<Monitor*> Platform::s_Monitors = {};
     std::vector<Cursor*> Platform::s_Cursors = {};
+    SlotMap<Window> Platform::s_WindowSlots = {};
+    SlotMap<Monitor> Platform::s_MonitorSlots = {};
+    SlotMap<Cursor> Platform::s_CursorSlots = {};
+    Cursor* Platform::s_StandardCursors[10] = {};
+    TaggedMap<uint64_t, Platform::CustomCursor, MemoryTag::Cursor> Platform::s_CustomCursors = {};
     uint64_t Platform::s_TimerOffset = 0;
     ThreadLocalStorage* Platform::s_ContextSlot = nullptr;
     Platform::Callbacks Platform::s_Callbacks = {};
+    Platform::ClipboardCache Platform::s_Clipboard = {};
 
 
 
@@ -18,6 +24,19 @@ namespace cpp_glfw
 
     bool Platform::Init()
     {
+        return Init(nullptr);
+    }
+
+    /// <summary> The allocator receives every allocation of the library, nullptr uses malloc and free </summary>
+    bool Platform::Init(const Allocator* allocator)
+    {
+        if (!Memory::SetAllocator(allocator))
+        {
+            return false;
+        }
+
+        Memory::ResetStats();
+
         if (!Platform::PlatformInit())
         {
             return false;
@@ -31,6 +50,11 @@ namespace cpp_glfw
 
         s_TimerOffset = PlatformGetTimerValue();
 
+        if (!GamepadMappings::Init())
+        {
+            return false;
+        }
+
         SetHintsToDefult();
 
         return true;
@@ -59,10 +83,25 @@ namespace cpp_glfw
         {
             for (size_t i = 0; i < s_Cursors.size(); i++)
             {
+                //removed instead of clearing the slot map, so ids kept across Terminate and Init never resolve to new cursors
+                s_CursorSlots.Remove(s_Cursors[i]->m_Id);
                 delete s_Cursors[i];
             }
         }
 
+        s_Monitors.clear();
+        s_Windows.clear();
+        s_Cursors.clear();
+        TaggedMap<uint64_t, CustomCursor, MemoryTag::Cursor>().swap(s_CustomCursors);
+        memset(s_StandardCursors, 0, sizeof(s_StandardCursors));
+
+        Input::TerminateJoysticks();
+        GamepadMappings::Terminate();
+        Edid::Terminate();
+        IconCache::Terminate();
+
+        s_Clipboard = {};
+
         delete s_ContextSlot;
 
         Platform::PlatformTerminate();
@@ -73,6 +112,25 @@ namespace cpp_glfw
     void Platform::PollEvents()
     {
         Platform::PlatformPollEvents();
+
+        Input::PollJoysticks();
+
+        for (Monitor* monitor : s_Monitors)
+        {
+            monitor->UpdateGammaTransition();
+        }
+
+        //by index, a text callback may open a window and grow the vector
+        for (size_t i = 0; i < s_Windows.size(); i++)
+        {
+            Window* window = s_Windows[i];
+            window->OnTextInput();
+
+            if (window->m_InputActions)
+            {
+                window->m_InputActions->Update(window);
+            }
+        }
     }
 
     void Platform::WaitEvents()
@@ -147,6 +205,12 @@ namespace cpp_glfw
             : nullptr;
     }
 
+    /// <summary> Returns nullptr if the window was destroyed, a stale id never resolves to a newer window </summary>
+    Window* Platform::GetWindowById(uint32_t id)
+    {
+        return s_WindowSlots.Get(id);
+    }
+
 
     double Platform::GetTime()
     {
@@ -189,6 +253,12 @@ namespace cpp_glfw
             : nullptr;
     }
 
+    /// <summary> Returns nullptr if the monitor was disconnected </summary>
+    Monitor* Platform::GetMonitorById(uint32_t id)
+    {
+        return s_MonitorSlots.Get(id);
+    }
+
 
     const char* Platform::GetKeyName(Key key, int32_t scancode)
     {
@@ -250,58 +320,290 @@ namespace cpp_glfw
     }
 
 
+    /// <summary> Returns the cached cursor if one was already created from the same pixels and hotspot </summary>
     Cursor* Platform::CreateCursor(const Image* image, int32_t xHot, int32_t yHot)
     {
+        const uint64_t hash = HashCursor(image, xHot, yHot);
+
+        auto it = s_CustomCursors.find(hash);
+        if (it != s_CustomCursors.end()
+            && IsSameCursor(it->second, image, xHot, yHot))
+        {
+            it->second.cursor->m_RefCount++;
+            return it->second.cursor;
+        }
+
         Cursor* cursor = Cursor::Create(image, xHot, yHot);
-        if (cursor)
+        if (!cursor)
+        {
+            return nullptr;
+        }
+
+        cursor->m_Hash = hash;
+        cursor->m_RefCount = 1;
+
+        AddCursor(cursor);
+
+        //a cursor colliding with a different interned one is still created, it is just not shared
+        if (it == s_CustomCursors.end())
         {
-            s_Cursors.push_back(cursor);
+            CustomCursor& custom = s_CustomCursors[hash];
+            custom.cursor = cursor;
+            custom.width = image->width;
+            custom.height = image->height;
+            custom.xHot = xHot;
+            custom.yHot = yHot;
+            custom.pixels.assign(image->pixels, image->pixels + (size_t)image->width * image->height * 4);
         }
         return cursor;
     }
 
+    /// <summary> Standard cursors are created on first use and kept until Terminate </summary>
     Cursor* Platform::CreateStandardCursor(CursorShape shape)
     {
+        const int32_t index = (int32_t)shape;
+        if (index < 0
+            || index >= (int32_t)(sizeof(s_StandardCursors) / sizeof(s_StandardCursors[0])))
+        {
+            CPP_GLFW_ERROR("Invalid standard cursor %d!", index);
+            return nullptr;
+        }
+
+        if (s_StandardCursors[index])
+        {
+            s_StandardCursors[index]->m_RefCount++;
+            return s_StandardCursors[index];
+        }
+
         Cursor* cursor = Cursor::Create(shape);
         if (cursor)
         {
-            s_Cursors.push_back(cursor);
+            cursor->m_Standard = true;
+            cursor->m_RefCount = 1;
+
+            AddCursor(cursor);
+            s_StandardCursors[index] = cursor;
         }
         return cursor;
     }
 
-    void Platform::DestroyCursor(Cursor* cursor)
+    /// <summary> Frames are converted once here and switched by the platform on a timer, durations are in seconds </summary>
+    Cursor* Platform::CreateAnimatedCursor(const std::vector<Image*>& images, const std::vector<double>& durations, int32_t xHot, int32_t yHot)
     {
-        //make sure the cursor is not being used by any window
-        for (Window* window : s_Windows)
+        if (images.empty()
+            || images.size() != durations.size())
         {
-            if (window->m_Cursor == cursor)
+            CPP_GLFW_ERROR("Animated cursor needs one duration for each of its %d frames!", (int32_t)images.size());
+            return nullptr;
+        }
+
+        for (double duration : durations)
+        {
+            if (duration <= 0.0)
             {
-                window->SetCursorType(nullptr);
+                CPP_GLFW_ERROR("Invalid animated cursor frame duration %f!", duration);
+                return nullptr;
             }
         }
 
-        for (uint32_t i = 0; i < s_Cursors.size(); i++)
+        Cursor* cursor = Cursor::Create(images, durations, xHot, yHot);
+        if (cursor)
+        {
+            cursor->m_RefCount = 1;
+
+            AddCursor(cursor);
+        }
+        return cursor;
+    }
+
+    /// <summary> Releases one reference, the cursor is only destroyed when the last one is released </summary>
+    void Platform::DestroyCursor(Cursor* cursor)
+    {
+        if (!cursor
+            || cursor->m_RefCount == 0)
         {
-            if (s_Cursors[i] == cursor)
+            return;
+        }
+
+        if (--cursor->m_RefCount > 0)
+        {
+            return;
+        }
+
+        //make sure the cursor is not being used by any window, the windows are only searched if one has it set
+        if (cursor->m_WindowCount > 0)
+        {
+            for (Window* window : s_Windows)
             {
-                s_Cursors.erase(s_Cursors.begin() + i);
-                break;
+                if (window->m_Cursor == cursor)
+                {
+                    window->SetCursorType(nullptr);
+                }
             }
         }
 
+        //interned standard cursors stay alive so the next request does not reload them
+        if (cursor->m_Standard)
+        {
+            return;
+        }
+
+        auto it = s_CustomCursors.find(cursor->m_Hash);
+        if (it != s_CustomCursors.end()
+            && it->second.cursor == cursor)
+        {
+            s_CustomCursors.erase(it);
+        }
+
+        s_CursorSlots.Remove(cursor->m_Id);
+
+        //swap with the last cursor so the removal does not shift the vector
+        Cursor* last = s_Cursors.back();
+        s_Cursors[cursor->m_Index] = last;
+        last->m_Index = cursor->m_Index;
+        s_Cursors.pop_back();
+
         delete cursor;
     }
 
 
+    /// <summary>
+    /// Returns nullptr once the cursor was destroyed. Custom cursors are destroyed with their last reference,
+    /// standard cursors stay alive until Terminate so their ids keep resolving after the last DestroyCursor.
+    /// </summary>
+    Cursor* Platform::GetCursorById(uint32_t id)
+    {
+        return s_CursorSlots.Get(id);
+    }
+
+
     const char* Platform::GetClipboardString()
     {
-        return PlatformGetClipboardString();
+        return GetClipboardString(nullptr);
+    }
+
+    /// <summary> Only reads the clipboard again after it changed, polling it every frame is cheap </summary>
+    const char* Platform::GetClipboardString(size_t* length)
+    {
+        if (length)
+        {
+            *length = 0;
+        }
+
+        //a sequence of zero means the change counter is not available, so nothing is cached
+        const uint32_t sequence = PlatformGetClipboardSequence();
+
+        if (!s_Clipboard.valid
+            || s_Clipboard.sequence != sequence
+            || sequence == 0)
+        {
+            s_Clipboard.sequence = sequence;
+            s_Clipboard.valid = PlatformGetClipboardString(&s_Clipboard.string, &s_Clipboard.available);
+
+            if (!s_Clipboard.valid)
+            {
+                return nullptr;
+            }
+        }
+
+        if (!s_Clipboard.available)
+        {
+            return nullptr;
+        }
+
+        if (length)
+        {
+            *length = s_Clipboard.string.size();
+        }
+
+        return s_Clipboard.string.c_str();
     }
 
     void Platform::SetClipboardString(const char* string)
     {
-        PlatformSetClipboardString(string);
+        if (!PlatformSetClipboardString(string))
+        {
+            return;
+        }
+
+        //we know what the clipboard holds now, so the next read does not have to convert it back
+        s_Clipboard.string = string;
+        s_Clipboard.available = true;
+        s_Clipboard.sequence = PlatformGetClipboardSequence();
+        s_Clipboard.valid = s_Clipboard.sequence != 0;
+    }
+
+    /// <summary>
+    /// Reads a MIME type from the clipboard without blocking, the callback is called from a later PollEvents.
+    /// Text types are returned as UTF-8 without a terminator.
+    /// </summary>
+    bool Platform::RequestClipboardData(const char* mimeType, ClipboardDataCallback callback, void* user)
+    {
+        if (!mimeType
+            || !callback)
+        {
+            CPP_GLFW_ERROR("Invalid clipboard request!");
+            return false;
+        }
+
+        return PlatformRequestClipboardData(mimeType, callback, user);
+    }
+
+    /// <summary>
+    /// Puts the MIME types on the clipboard without copying any data.
+    /// The provider is called on the event thread when an application pastes one of them, until something else is copied.
+    /// </summary>
+    bool Platform::OfferClipboardData(const std::vector<std::string>& mimeTypes, ClipboardProviderCallback provider, void* user)
+    {
+        if (mimeTypes.empty()
+            || !provider)
+        {
+            CPP_GLFW_ERROR("Invalid clipboard offer!");
+            return false;
+        }
+
+        return PlatformOfferClipboardData(mimeTypes, provider, user);
+    }
+
+
+    /// <summary> Returns nullptr if the backend could not be initialized, check IsPresent for a connected device </summary>
+    Joystick* Platform::GetJoystick(int32_t jid)
+    {
+        if (jid < 0
+            || jid >= CPP_GLFW_JOYSTICK_COUNT)
+        {
+            CPP_GLFW_ERROR("Invalid joystick ID %i", jid);
+            return nullptr;
+        }
+
+        if (!Input::InitJoysticks())
+        {
+            return nullptr;
+        }
+
+        return &Input::s_Joysticks[jid];
+    }
+
+    bool Platform::UpdateGamepadMappings(const char* string)
+    {
+        if (!GamepadMappings::Update(string, strlen(string)))
+        {
+            return false;
+        }
+
+        Input::RefreshGamepadMappings();
+        return true;
+    }
+
+    bool Platform::LoadGamepadMappings(const std::string& path)
+    {
+        if (!GamepadMappings::Load(path))
+        {
+            return false;
+        }
+
+        Input::RefreshGamepadMappings();
+        return true;
     }
 
 
@@ -314,5 +616,54 @@ namespace cpp_glfw
     {
         s_Callbacks.monitorDisconnected = callback;
     }
-}
 
+    void Platform::SetMonitorChangedCallback(MonitorChangedCallback callback)
+    {
+        s_Callbacks.monitorChanged = callback;
+    }
+
+    void Platform::SetJoystickConnectedCallback(JoystickCallback callback)
+    {
+        //the polling thread only runs once someone is interested in joysticks
+        Input::InitJoysticks();
+        s_Callbacks.joystickConnected = callback;
+    }
+
+    void Platform::SetJoystickDisconnectedCallback(JoystickCallback callback)
+    {
+        Input::InitJoysticks();
+        s_Callbacks.joystickDisconnected = callback;
+    }
+
+    void Platform::SetClipboardCallback(ClipboardCallback callback)
+    {
+        s_Callbacks.clipboardChanged = callback;
+    }
+
+
+
+    ///////////////////////////////////////// UTILS ///////////////////////////////////////////
+
+    uint64_t Platform::HashCursor(const Image* image, int32_t xHot, int32_t yHot)
+    {
+        uint64_t hash = Utils::HashWord((uint64_t)image->width << 32 | (uint32_t)image->height, Utils::HashSeed);
+        hash = Utils::HashWord((uint64_t)(uint32_t)xHot << 32 | (uint32_t)yHot, hash);
+        return Utils::Hash(image->pixels, (size_t)image->width * image->height * 4, hash);
+    }
+
+    bool Platform::IsSameCursor(const CustomCursor& custom, const Image* image, int32_t xHot, int32_t yHot)
+    {
+        return custom.width == image->width
+            && custom.height == image->height
+            && custom.xHot == xHot
+            && custom.yHot == yHot
+            && memcmp(custom.pixels.data(), image->pixels, custom.pixels.size()) == 0;
+    }
+
+    void Platform::AddCursor(Cursor* cursor)
+    {
+        cursor->m_Index = (uint32_t)s_Cursors.size();
+        cursor->m_Id = s_CursorSlots.Insert(cursor);
+        s_Cursors.push_back(cursor);
+    }
+}
@@ -2,9 +2,17 @@
 
 #include "engine/core/Base.h"
 #include "engine/core/ThreadLocalStorage.h"
+#include "engine/core/SlotMap.h"
 #include "engine/core/Context.h"
+#include "engine/core/FrameRecorder.h"
+#include "engine/core/PixelConversion.h"
+#include "engine/core/IconCache.h"
 #include "engine/core/EglContext.h"
+#include "engine/core/GamepadMappings.h"
+#include "engine/core/Joystick.h"
+#include "engine/core/JoystickConditioning.h"
 #include "engine/core/Input.h"
+#include "engine/core/InputActions.h"
 #include "engine/core/Cursor.h"
 #include "engine/core/Monitor.h"
 #include "engine/core/Window.h"
@@ -12,7 +20,18 @@
 namespace cpp_glfw
 {
     typedef void(*MonitorCallback)(Monitor*);
-    typedef void(*JoystickCallback)(int32_t, int32_t);
+    typedef void(*MonitorChangedCallback)(Monitor*, MonitorProperty); //only the properties that changed are set
+    typedef void(*JoystickCallback)(int32_t, int32_t); //joystick id, 1 if connected 0 if disconnected
+    typedef void(*ClipboardCallback)(); //called from PollEvents after any application changed the clipboard
+    typedef void(*ClipboardDataCallback)(const char*, const uint8_t*, size_t, void*); //mime type, data or nullptr if unavailable, size, user pointer
+    typedef bool(*ClipboardProviderCallback)(const char*, std::vector<uint8_t>*, void*); //mime type, data to fill, user pointer
+
+    struct MappedFile
+    {
+        const char* data;
+        size_t size;
+        void* handle;
+    };
 
     struct InitConfig
     {
@@ -40,17 +59,57 @@ namespace cpp_glfw
         static std::vector<Monitor*> s_Monitors;
         static std::vector<Cursor*> s_Cursors;
 
+        //resolve the ids of the objects above, windows and monitors register themselves on construction
+        static SlotMap<Window> s_WindowSlots;
+        static SlotMap<Monitor> s_MonitorSlots;
+        static SlotMap<Cursor> s_CursorSlots;
+
+        //custom cursors keep a copy of their image, a hash hit with different contents is treated as a miss
+        struct CustomCursor
+        {
+            Cursor* cursor;
+            int32_t width;
+            int32_t height;
+            int32_t xHot;
+            int32_t yHot;
+            TaggedVector<uint8_t, MemoryTag::Cursor> pixels;
+        };
+
+        //standard cursors are created once and custom ones are shared by content, both are reference counted
+        static Cursor* s_StandardCursors[10];
+        static TaggedMap<uint64_t, CustomCursor, MemoryTag::Cursor> s_CustomCursors;
+
     protected:
         static struct Callbacks
         {
             MonitorCallback monitorConnected;
             MonitorCallback monitorDisconnected;
+            MonitorChangedCallback monitorChanged;
             JoystickCallback joystickConnected;
             JoystickCallback joystickDisconnected;
+            ClipboardCallback clipboardChanged;
         } s_Callbacks;
 
+    protected:
+        //the last clipboard string read, valid until the OS change counter moves
+        static struct ClipboardCache
+        {
+            TaggedString<MemoryTag::Clipboard> string;
+            uint32_t sequence;
+            bool valid;
+            bool available; //false if the clipboard held no text
+        } s_Clipboard;
+
+    public:
+        friend class Joystick;
+        friend class GamepadMappings;
+        friend class FrameRecorder;
+        friend class Window;
+        friend class Monitor;
+
     public: CPP_GLFW_PUBLIC_API
         static bool Init();
+        static bool Init(const Allocator* allocator);
         static void Terminate();
 
         static Window* OpenWindow(const std::string& title, int32_t width, int32_t height, Monitor* monitor);
@@ -59,9 +118,11 @@ namespace cpp_glfw
 
         static const std::vector<Window*>& GetWindows();
         static Window* GetPrimaryWindow();
+        static Window* GetWindowById(uint32_t id);
 
         static const std::vector<Monitor*>& GetMonitors();
         static Monitor* GetPrimaryMonitor();
+        static Monitor* GetMonitorById(uint32_t id);
 
         static double GetTime();
         static void SetTime(double time);
@@ -87,15 +148,26 @@ namespace cpp_glfw
 
         static Cursor* CreateCursor(const Image* image, int32_t xHot, int32_t yHot);
         static Cursor* CreateStandardCursor(CursorShape shape);
+        static Cursor* CreateAnimatedCursor(const std::vector<Image*>& images, const std::vector<double>& durations, int32_t xHot, int32_t yHot);
         static void DestroyCursor(Cursor* cursor);
+        static Cursor* GetCursorById(uint32_t id);
 
         static const char* GetClipboardString();
+        static const char* GetClipboardString(size_t* length);
         static void SetClipboardString(const char* string);
+        static bool RequestClipboardData(const char* mimeType, ClipboardDataCallback callback, void* user);
+        static bool OfferClipboardData(const std::vector<std::string>& mimeTypes, ClipboardProviderCallback provider, void* user);
+
+        static Joystick* GetJoystick(int32_t jid);
+        static bool UpdateGamepadMappings(const char* string);
+        static bool LoadGamepadMappings(const std::string& path);
 
         static void SetMonitorConnectedCallback(MonitorCallback callback);
         static void SetMonitorDisconnectedCallback(MonitorCallback callback);
+        static void SetMonitorChangedCallback(MonitorChangedCallback callback);
         static void SetJoystickConnectedCallback(JoystickCallback callback);
         static void SetJoystickDisconnectedCallback(JoystickCallback callback);
+        static void SetClipboardCallback(ClipboardCallback callback);
 
         static void PollEvents();
         static void WaitEvents();
@@ -116,8 +188,19 @@ namespace cpp_glfw
         static uint64_t PlatformGetTimerValue();
         static uint64_t PlatformGetTimerFrequency();
 
-        static const char* PlatformGetClipboardString();
-        static void PlatformSetClipboardString(const char* string);
+        static uint32_t PlatformGetClipboardSequence();
+        static bool PlatformGetClipboardString(TaggedString<MemoryTag::Clipboard>* string, bool* available);
+        static bool PlatformSetClipboardString(const char* string);
+        static bool PlatformRequestClipboardData(const char* mimeType, ClipboardDataCallback callback, void* user);
+        static bool PlatformOfferClipboardData(const std::vector<std::string>& mimeTypes, ClipboardProviderCallback provider, void* user);
+
+        static bool PlatformMapFile(const std::string& path, MappedFile* file);
+        static void PlatformUnmapFile(MappedFile* file);
+        static const char* PlatformGetMappingName();
+
+        static bool PlatformCreateOutputFile(const std::string& path, OutputFile* file);
+        static bool PlatformWriteOutputFile(OutputFile* file, const void* data, size_t size);
+        static bool PlatformCloseOutputFile(OutputFile* file);
 
         static const char* PlatformGetScancodeName(int32_t scancode);
         static int32_t PlatformGetKeyScancode(Key key);
@@ -130,5 +213,10 @@ namespace cpp_glfw
         static EGLenum PlatformGetEglPlatform(EGLint** attribs);
         static EGLNativeDisplayType PlatformGetEglNativeDisplay();
         static EGLNativeWindowType PlatformGetEglNativeWindow(Window* window);
+
+    protected: CPP_GLFW_UTILS
+        static uint64_t HashCursor(const Image* image, int32_t xHot, int32_t yHot);
+        static bool IsSameCursor(const CustomCursor& custom, const Image* image, int32_t xHot, int32_t yHot);
+        static void AddCursor(Cursor* cursor);
     };
 }
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "engine/core/Base.h"
+
+namespace cpp_glfw
+{
+    /// <summary>
+    /// Maps 32-bit ids to objects in constant time. The low 16 bits of an id are the slot index and the high 16 bits its generation,
+    /// which is bumped when the slot is freed, so an id of a destroyed object stops resolving instead of returning whatever reused the slot.
+    /// Freed slots are kept in an intrusive free list and the id zero is never handed out.
+    /// </summary>
+    template<typename T>
+    class SlotMap
+    {
+    protected:
+        struct Slot
+        {
+            T* object;
+            uint32_t generation;
+            uint32_t nextFree;
+        };
+
+        static constexpr uint32_t IndexBits = 16;
+        static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+        static constexpr uint32_t NoSlot = UINT32_MAX;
+
+    protected:
+        std::vector<Slot> m_Slots;
+        uint32_t m_FreeHead = NoSlot;
+        uint32_t m_Count = 0;
+
+    public: CPP_GLFW_INTERNAL_API
+        /// <summary> Returns the id of the object, zero if every slot is taken </summary>
+        uint32_t Insert(T* object)
+        {
+            uint32_t index = m_FreeHead;
+
+            if (index != NoSlot)
+            {
+                m_FreeHead = m_Slots[index].nextFree;
+            }
+            else
+            {
+                if (m_Slots.size() > IndexMask)
+                {
+                    CPP_GLFW_ERROR("Slot map is full!");
+                    return 0;
+                }
+
+                index = (uint32_t)m_Slots.size();
+                m_Slots.push_back({ nullptr, 1, NoSlot });
+            }
+
+            Slot& slot = m_Slots[index];
+            slot.object = object;
+            slot.nextFree = NoSlot;
+            m_Count++;
+
+            return slot.generation << IndexBits | index;
+        }
+
+        /// <summary> Returns nullptr for ids of removed objects </summary>
+        T* Get(uint32_t id) const
+        {
+            const uint32_t index = id & IndexMask;
+
+            if (index >= m_Slots.size()
+                || m_Slots[index].generation != id >> IndexBits)
+            {
+                return nullptr;
+            }
+
+            return m_Slots[index].object;
+        }
+
+        bool Remove(uint32_t id)
+        {
+            if (!Get(id))
+            {
+                return false;
+            }
+
+            Slot& slot = m_Slots[id & IndexMask];
+            slot.object = nullptr;
+
+            //generation zero is skipped so no id is ever zero
+            slot.generation = (slot.generation + 1) & 0xffff;
+            if (slot.generation == 0)
+            {
+                slot.generation = 1;
+            }
+
+            slot.nextFree = m_FreeHead;
+            m_FreeHead = id & IndexMask;
+            m_Count--;
+
+            return true;
+        }
+
+        uint32_t GetCount() const
+        {
+            return m_Count;
+        }
+    };
+}
@@ -6,6 +6,8 @@ namespace cpp_glfw
 {
     class ThreadLocalStorage
     {
+        CPP_GLFW_MEMORY_TAG(MemoryTag::General)
+
     public:
         static ThreadLocalStorage* Create();
 
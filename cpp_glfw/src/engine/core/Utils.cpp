@@ -17,5 +17,66 @@ namespace cpp_glfw
         if (a > b) return a;
         return b;
     }
-}
 
+    /// <summary> Writes the UTF-8 encoding of the codepoint to target (at least 4 bytes) and returns its length </summary>
+    size_t Utils::EncodeUTF8(uint32_t codepoint, char* target)
+    {
+        size_t count = 0;
+
+        if (codepoint < 0x80)
+        {
+            target[count++] = (char)codepoint;
+        }
+        else if (codepoint < 0x800)
+        {
+            target[count++] = (char)((codepoint >> 6) | 0xc0);
+            target[count++] = (char)((codepoint & 0x3f) | 0x80);
+        }
+        else if (codepoint < 0x10000)
+        {
+            target[count++] = (char)((codepoint >> 12) | 0xe0);
+            target[count++] = (char)(((codepoint >> 6) & 0x3f) | 0x80);
+            target[count++] = (char)((codepoint & 0x3f) | 0x80);
+        }
+        else if (codepoint < 0x110000)
+        {
+            target[count++] = (char)((codepoint >> 18) | 0xf0);
+            target[count++] = (char)(((codepoint >> 12) & 0x3f) | 0x80);
+            target[count++] = (char)(((codepoint >> 6) & 0x3f) | 0x80);
+            target[count++] = (char)((codepoint & 0x3f) | 0x80);
+        }
+
+        return count;
+    }
+
+    /// <summary>
+    /// FNV-1a style hash of a buffer, eight bytes at a time with an extra shift so the high bits reach the low ones.
+    /// Chained through the seed, so several buffers and values can be hashed into one key. Not stable across versions.
+    /// </summary>
+    uint64_t Utils::Hash(const void* data, size_t size, uint64_t seed)
+    {
+        const uint8_t* bytes = (const uint8_t*)data;
+        uint64_t hash = seed;
+
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            uint64_t word;
+            memcpy(&word, bytes + i, 8);
+            hash = HashWord(word, hash);
+        }
+
+        for (; i < size; i++)
+        {
+            hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+        }
+
+        return hash;
+    }
+
+    uint64_t Utils::HashWord(uint64_t word, uint64_t seed)
+    {
+        const uint64_t hash = (seed ^ word) * 0x100000001b3ull;
+        return hash ^ (hash >> 29);
+    }
+}
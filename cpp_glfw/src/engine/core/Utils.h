@@ -6,9 +6,16 @@ namespace cpp_glfw
 {
     class Utils
     {
+    public:
+        static constexpr uint64_t HashSeed = 0xcbf29ce484222325ull;
+
     public:
         static float fminf(float a, float b);
         static float fmaxf(float a, float b);
+        static size_t EncodeUTF8(uint32_t codepoint, char* target);
+
+        static uint64_t Hash(const void* data, size_t size, uint64_t seed = HashSeed);
+        static uint64_t HashWord(uint64_t word, uint64_t seed);
 
         template<typename T>
         static int32_t indexOf(const std::vector<T>& vec, const T& element)
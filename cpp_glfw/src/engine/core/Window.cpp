@@ -33,7 +33,8 @@ namespace cpp_glfw
             return nullptr;
         }
 
-        if (contextConfig->api != ContextAPI::None)
+        if (contextConfig->api != ContextAPI::None
+            && contextConfig->api != ContextAPI::Software)
         {
             if (!Context::RefreshContextAttribs(window, contextConfig))
             {
@@ -63,6 +64,9 @@ namespace cpp_glfw
             }
         }
 
+        //from here on the events keep the properties current
+        window->Refresh();
+
         return window;
     }
 
@@ -73,6 +77,8 @@ namespace cpp_glfw
     Window::Window(const std::string& title, int32_t width, int32_t height, 
                    const WindowConfig* windowConfig, const ContextConfig* contextConfig, const FramebufferConfig* framebufferConfig, Monitor* monitor)
     {
+        m_Id = Platform::s_WindowSlots.Insert(this);
+
         m_Title = title;
         m_Width = width;
         m_Height = height;
@@ -99,15 +105,30 @@ namespace cpp_glfw
         m_VideoMode.refreshRate = Platform::s_Hints.refreshRate;
 
         m_Monitor = monitor;
+
+        m_Properties = {};
+        m_Properties.width = width;
+        m_Properties.height = height;
+        m_Properties.framebufferWidth = width;
+        m_Properties.framebufferHeight = height;
+        m_Properties.xScale = 1.0f;
+        m_Properties.yScale = 1.0f;
     }
 
     Window::~Window()
     {
+        Platform::s_WindowSlots.Remove(m_Id);
+
         //the window's context must not be current on another thread when the window is destroyed
         if (Platform::s_ContextSlot->Get() == this)
         {
             Context::MakeContextCurrent(nullptr);
         }
+
+        if (m_Cursor)
+        {
+            m_Cursor->m_WindowCount--;
+        }
     }
 
 
@@ -131,12 +152,12 @@ namespace cpp_glfw
 
     bool Window::IsFocused() const
     {
-        return PlatformIsFocused();
+        return m_Properties.focused;
     }
 
     bool Window::IsHovered() const
     {
-        return PlatformIsHovered();
+        return m_Properties.hovered;
     }
 
     bool Window::IsFloating() const
@@ -187,26 +208,20 @@ namespace cpp_glfw
 
     void Window::GetPosition(int32_t* x, int32_t* y) const
     {
-        if (x) *x = 0;
-        if (y) *y = 0;
-
-        PlatformGetPosition(x, y);
+        if (x) *x = m_Properties.x;
+        if (y) *y = m_Properties.y;
     }
 
     void Window::GetSize(int32_t* width, int32_t* height)
     {
-        if (width) *width = 0;
-        if (height) *height = 0;
-
-        PlatformGetSize(width, height);
+        if (width) *width = m_Properties.width;
+        if (height) *height = m_Properties.height;
     }
 
     void Window::GetFramebufferSize(int32_t* width, int32_t* height) const
     {
-        if (width) *width = 0;
-        if (height) *height = 0;
-
-        PlatformGetFramebufferSize(width, height);
+        if (width) *width = m_Properties.framebufferWidth;
+        if (height) *height = m_Properties.framebufferHeight;
     }
 
     void Window::GetFrameSize(int32_t* left, int32_t* top, int32_t* right, int32_t* bottom)
@@ -221,10 +236,8 @@ namespace cpp_glfw
 
     void Window::GetContentScale(float* xScale, float* yScale)
     {
-        if (xScale) *xScale = 0.0f;
-        if (yScale) *yScale = 0.0f;
-
-        PlatformGetContentScale(xScale, yScale);
+        if (xScale) *xScale = m_Properties.xScale;
+        if (yScale) *yScale = m_Properties.yScale;
     }
 
     float Window::GetOpacity()
@@ -287,8 +300,14 @@ namespace cpp_glfw
             if (x) *x = m_VirtualCursorPositionX;
             if (y) *y = m_VirtualCursorPositionY;
         }
+        else if (m_Properties.hovered)
+        {
+            if (x) *x = m_Properties.cursorX;
+            if (y) *y = m_Properties.cursorY;
+        }
         else
         {
+            //no events arrive while the cursor is outside, so only the platform knows where it is
             PlatformGetCursorPosition(x, y);
         }
     }
@@ -298,11 +317,34 @@ namespace cpp_glfw
         return m_Context;
     }
 
+    InputActionMap* Window::GetInputActionMap()
+    {
+        return m_InputActions;
+    }
+
     void* Window::GetNativeHandle() const
     {
         return PlatformGetHandle();
     }
 
+    /// <summary> Stable id for referring to the window without keeping a pointer, see Platform::GetWindowById </summary>
+    uint32_t Window::GetId() const
+    {
+        return m_Id;
+    }
+
+    /// <summary> Reads the cached properties synchronously from the platform, for callers that cannot wait for the events </summary>
+    void Window::Refresh()
+    {
+        PlatformGetPosition(&m_Properties.x, &m_Properties.y);
+        PlatformGetSize(&m_Properties.width, &m_Properties.height);
+        PlatformGetFramebufferSize(&m_Properties.framebufferWidth, &m_Properties.framebufferHeight);
+        PlatformGetContentScale(&m_Properties.xScale, &m_Properties.yScale);
+        PlatformGetCursorPosition(&m_Properties.cursorX, &m_Properties.cursorY);
+        m_Properties.focused = PlatformIsFocused();
+        m_Properties.hovered = PlatformIsHovered();
+    }
+
 
     void Window::SetTitle(const std::string& title)
     {
@@ -328,13 +370,36 @@ namespace cpp_glfw
 
     void Window::SetCursorType(Cursor* cursor)
     {
+        if (m_Cursor == cursor)
+        {
+            return;
+        }
+
+        if (m_Cursor)
+        {
+            m_Cursor->m_WindowCount--;
+        }
+
         m_Cursor = cursor;
 
+        if (m_Cursor)
+        {
+            m_Cursor->m_WindowCount++;
+        }
+
         PlatformSetCursorType(cursor);
     }
 
     void Window::SetPosition(int32_t x, int32_t y)
     {
+        if (m_UpdateDepth)
+        {
+            m_Update.changed = m_Update.changed | WindowProperty::Position;
+            m_Update.x = x;
+            m_Update.y = y;
+            return;
+        }
+
         if (m_Monitor)
         {
             return;
@@ -351,6 +416,14 @@ namespace cpp_glfw
             CPP_GLFW_ERROR("Invalid window size %i x %i!", width, height);
         }
 
+        if (m_UpdateDepth)
+        {
+            m_Update.changed = m_Update.changed | WindowProperty::Size;
+            m_Update.width = width;
+            m_Update.height = height;
+            return;
+        }
+
         m_VideoMode.width = width;
         m_VideoMode.height = height;
 
@@ -435,6 +508,13 @@ namespace cpp_glfw
 
     void Window::SetFloating(bool value)
     {
+        if (m_UpdateDepth)
+        {
+            m_Update.changed = m_Update.changed | WindowProperty::Floating;
+            m_Update.floating = value;
+            return;
+        }
+
         m_Floating = value;
 
         if (!m_Monitor)
@@ -445,6 +525,13 @@ namespace cpp_glfw
 
     void Window::SetDecorated(bool value)
     {
+        if (m_UpdateDepth)
+        {
+            m_Update.changed = m_Update.changed | WindowProperty::Decorated;
+            m_Update.decorated = value;
+            return;
+        }
+
         m_Decorated = value;
 
         if (!m_Monitor)
@@ -500,6 +587,19 @@ namespace cpp_glfw
             return;
         }
 
+        //the windowed rect also counts as a position and size change, later calls in the update override it
+        if (m_UpdateDepth)
+        {
+            m_Update.changed = m_Update.changed | WindowProperty::Monitor | WindowProperty::Position | WindowProperty::Size;
+            m_Update.monitor = monitor;
+            m_Update.x = x;
+            m_Update.y = y;
+            m_Update.width = width;
+            m_Update.height = height;
+            m_Update.refreshRate = refreshRate;
+            return;
+        }
+
         m_VideoMode.width = width;
         m_VideoMode.height = height;
         m_VideoMode.refreshRate = refreshRate;
@@ -530,6 +630,9 @@ namespace cpp_glfw
 
             PlatformGetCursorPosition(&m_VirtualCursorPositionX, &m_VirtualCursorPositionY);
             PlatformSetCursorMode(cursorMode);
+
+            //leaving disabled mode moves the cursor back without waiting for an event
+            PlatformGetCursorPosition(&m_Properties.cursorX, &m_Properties.cursorY);
         }
         else if (mode == InputMode::StickyKeys)
         {
@@ -630,6 +733,123 @@ namespace cpp_glfw
         {
             //update system cursor position
             PlatformSetCursorPosition(x, y);
+
+            m_Properties.cursorX = x;
+            m_Properties.cursorY = y;
+        }
+    }
+
+    /// <summary> The map is evaluated against this window's input state on every Platform::PollEvents </summary>
+    void Window::SetInputActionMap(InputActionMap* map)
+    {
+        if (map)
+        {
+            map->Compile();
+        }
+
+        m_InputActions = map;
+    }
+
+    /// <summary>
+    /// Drops with more paths than this are delivered in batches over the following PollEvents, so the UI keeps running.
+    /// Each batch calls the drop callbacks, DropPayload::GetFirstIndex tells where the batch starts.
+    /// </summary>
+    void Window::SetDropBatchSize(uint32_t size)
+    {
+        m_DropBatchSize = size;
+    }
+
+    /// <summary>
+    /// Collects SetPosition, SetSize, SetDecorated, SetFloating and SetMonitor until the matching Commit.
+    /// Updates can nest, only the outermost Commit applies them.
+    /// </summary>
+    void Window::BeginUpdate()
+    {
+        if (m_UpdateDepth++ == 0)
+        {
+            m_Update = {};
+        }
+    }
+
+    /// <summary> Applies the collected changes with one platform call and reports the resulting size and position once </summary>
+    void Window::Commit()
+    {
+        if (!m_UpdateDepth)
+        {
+            CPP_GLFW_ERROR("Commit called without BeginUpdate!");
+            return;
+        }
+
+        if (--m_UpdateDepth
+            || m_Update.changed == WindowProperty::None)
+        {
+            return;
+        }
+
+        const WindowUpdate update = m_Update;
+        m_Update = {};
+
+        //the platform reads the new state while building the window styles
+        if ((update.changed & WindowProperty::Decorated) != WindowProperty::None)
+        {
+            m_Decorated = update.decorated;
+        }
+
+        if ((update.changed & WindowProperty::Floating) != WindowProperty::None)
+        {
+            m_Floating = update.floating;
+        }
+
+        if ((update.changed & WindowProperty::Size) != WindowProperty::None)
+        {
+            m_VideoMode.width = update.width;
+            m_VideoMode.height = update.height;
+        }
+
+        if ((update.changed & WindowProperty::Monitor) != WindowProperty::None)
+        {
+            m_VideoMode.refreshRate = update.refreshRate;
+        }
+
+        const WindowProperties before = m_Properties;
+        m_Committing = true;
+
+        if ((update.changed & WindowProperty::Monitor) != WindowProperty::None
+            && update.monitor != m_Monitor)
+        {
+            PlatformSetMonitor(update.monitor, update.x, update.y, update.width, update.height, update.refreshRate);
+        }
+        else if (m_Monitor)
+        {
+            //a full screen window only follows its video mode, the rest applies once it leaves the monitor
+            if ((update.changed & WindowProperty::Size) != WindowProperty::None)
+            {
+                PlatformSetSize(update.width, update.height);
+            }
+        }
+        else
+        {
+            PlatformCommit(update.changed, update.x, update.y, update.width, update.height);
+        }
+
+        m_Committing = false;
+
+        if (m_Properties.framebufferWidth != before.framebufferWidth
+            || m_Properties.framebufferHeight != before.framebufferHeight)
+        {
+            OnFramebufferSizeChanged(m_Properties.framebufferWidth, m_Properties.framebufferHeight);
+        }
+
+        if (m_Properties.width != before.width
+            || m_Properties.height != before.height)
+        {
+            OnSizeChanged(m_Properties.width, m_Properties.height);
+        }
+
+        if (m_Properties.x != before.x
+            || m_Properties.y != before.y)
+        {
+            OnPositionChanged(m_Properties.x, m_Properties.y);
         }
     }
 
@@ -782,13 +1002,34 @@ namespace cpp_glfw
         m_Callbacks.drop = callback;
     }
 
+    void Window::SetDropPayloadCallback(WindowDropPayloadCallback callback)
+    {
+        m_Callbacks.dropPayload = callback;
+    }
+
+    /// <summary> Receives all text typed or pasted during a PollEvents as a single utf-8 string </summary>
+    void Window::SetTextCallback(WindowTextCallback callback)
+    {
+        m_Callbacks.text = callback;
+    }
+
+    /// <summary> Same as the text callback, plus the modifiers of each codepoint </summary>
+    void Window::SetTextModsCallback(WindowTextModsCallback callback)
+    {
+        m_Callbacks.textMods = callback;
+    }
+
 
 
     ///////////////////////////////////// EVENT INPUT API /////////////////////////////////////
 
     void Window::OnPositionChanged(int32_t x, int32_t y)
     {
-        if (m_Callbacks.position)
+        m_Properties.x = x;
+        m_Properties.y = y;
+
+        if (m_Callbacks.position
+            && !m_Committing)
         {
             m_Callbacks.position(this, x, y);
         }
@@ -796,7 +1037,11 @@ namespace cpp_glfw
 
     void Window::OnSizeChanged(int32_t width, int32_t height)
     {
-        if (m_Callbacks.size)
+        m_Properties.width = width;
+        m_Properties.height = height;
+
+        if (m_Callbacks.size
+            && !m_Committing)
         {
             m_Callbacks.size(this, width, height);
         }
@@ -822,6 +1067,8 @@ namespace cpp_glfw
 
     void Window::OnFocus(bool focused)
     {
+        m_Properties.focused = focused;
+
         if (m_Callbacks.focus)
         {
             m_Callbacks.focus(this, focused);
@@ -867,7 +1114,11 @@ namespace cpp_glfw
 
     void Window::OnFramebufferSizeChanged(int32_t width, int32_t height)
     {
-        if (m_Callbacks.framebufferSize)
+        m_Properties.framebufferWidth = width;
+        m_Properties.framebufferHeight = height;
+
+        if (m_Callbacks.framebufferSize
+            && !m_Committing)
         {
             m_Callbacks.framebufferSize(this, width, height);
         }
@@ -875,6 +1126,9 @@ namespace cpp_glfw
 
     void Window::OnContentScaleChanged(float xScale, float yScale)
     {
+        m_Properties.xScale = xScale;
+        m_Properties.yScale = yScale;
+
         if (m_Callbacks.contentScale)
         {
             m_Callbacks.contentScale(this, xScale, yScale);
@@ -906,6 +1160,13 @@ namespace cpp_glfw
 
     void Window::OnCursorPositionChanged(double x, double y)
     {
+        //in disabled mode the position is virtual, GetCursorPosition reads it from m_VirtualCursorPosition
+        if (m_CursorMode != CursorMode::Disabled)
+        {
+            m_Properties.cursorX = x;
+            m_Properties.cursorY = y;
+        }
+
         if (m_VirtualCursorPositionX == x
             && m_VirtualCursorPositionY == y)
         {
@@ -923,6 +1184,8 @@ namespace cpp_glfw
 
     void Window::OnCursorEnter(bool entered)
     {
+        m_Properties.hovered = entered;
+
         if (m_Callbacks.cursorEnter)
         {
             m_Callbacks.cursorEnter(this, entered);
@@ -1006,6 +1269,15 @@ namespace cpp_glfw
             {
                 m_Callbacks.character(this, codepoint);
             }
+
+            if (m_Callbacks.text
+                || m_Callbacks.textMods)
+            {
+                //accumulate until the end of PollEvents, see OnTextInput
+                char encoded[4];
+                m_TextInput.append(encoded, Utils::EncodeUTF8(codepoint, encoded));
+                m_TextInputMods.push_back(mods);
+            }
         }
     }
 
@@ -1017,33 +1289,39 @@ namespace cpp_glfw
         }
     }
 
-    void Window::OnDrop(uint32_t count, const char** paths)
+    void Window::OnTextInput()
     {
-        if (m_Callbacks.drop)
+        if (m_TextInput.empty())
         {
-            m_Callbacks.drop(this, count, paths);
+            return;
         }
-    }
 
+        if (m_Callbacks.text)
+        {
+            m_Callbacks.text(this, m_TextInput.c_str(), m_TextInput.size());
+        }
 
+        if (m_Callbacks.textMods)
+        {
+            m_Callbacks.textMods(this, m_TextInput.c_str(), m_TextInput.size(), m_TextInputMods.data(), m_TextInputMods.size());
+        }
 
-    ///////////////////////////////////////// UTILS ///////////////////////////////////////////
+        //clearing keeps the capacity, so steady typing does not allocate
+        m_TextInput.clear();
+        m_TextInputMods.clear();
+    }
 
-    const Image* Window::ChooseImage(const std::vector<Image*>& images, int32_t width, int32_t height)
+    void Window::OnDrop(const DropPayload* payload)
     {
-        int32_t leastDiff = INT_MAX;
-        const Image* closest = NULL;
-
-        for (Image* image : images)
+        if (m_Callbacks.dropPayload)
         {
-            const int32_t currDiff = abs(image->width * image->height - width * height);
-            if (currDiff < leastDiff)
-            {
-                closest = image;
-                leastDiff = currDiff;
-            }
+            m_Callbacks.dropPayload(this, payload);
         }
 
-        return closest;
+        //the pointer table is only built for the old callback
+        if (m_Callbacks.drop)
+        {
+            m_Callbacks.drop(this, payload->GetCount(), payload->GetPaths());
+        }
     }
 }
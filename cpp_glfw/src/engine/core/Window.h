@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/core/Base.h"
+#include "engine/core/DropPayload.h"
 
 class cpp_glfw::Monitor;
 
@@ -23,6 +24,20 @@ namespace cpp_glfw
     typedef void(*WindowCharCallback)(Window*, uint32_t);
     typedef void(*WindowCharModsCallback)(Window*, uint32_t, KeyMods);
     typedef void(*WindowDropCallback)(Window*, uint32_t, const char**);
+    typedef void(*WindowDropPayloadCallback)(Window*, const DropPayload*);
+    typedef void(*WindowTextCallback)(Window*, const char*, size_t);
+    typedef void(*WindowTextModsCallback)(Window*, const char*, size_t, const KeyMods*, size_t);
+
+    enum class WindowProperty
+    {
+        None = 0,
+        Position = 1 << 0,
+        Size = 1 << 1,
+        Decorated = 1 << 2,
+        Floating = 1 << 3,
+        Monitor = 1 << 4
+    };
+    FLAG_OPERATORS(WindowProperty)
 
     struct WindowConfig
     {
@@ -91,6 +106,8 @@ namespace cpp_glfw
 
     class Window
     {
+        CPP_GLFW_MEMORY_TAG(MemoryTag::Window)
+
     protected:
         std::string m_Title = {};
         int32_t m_Width = 0; //cached used to filter out duplicate events
@@ -118,11 +135,50 @@ namespace cpp_glfw
         bool m_RawMouseMotion = false;
         double m_VirtualCursorPositionX = 0.0;
         double m_VirtualCursorPositionY = 0.0;
+        TaggedString<MemoryTag::Input> m_TextInput = {}; //utf-8 text received since the last PollEvents, reused between frames
+        TaggedVector<KeyMods, MemoryTag::Input> m_TextInputMods = {}; //modifiers of each codepoint in m_TextInput
+        DropPayload m_DropPayload = {}; //reused by every drop, so its arena only grows for larger drops
+        uint32_t m_DropBatchSize = 0; //paths per callback for large drops, zero delivers a drop at once
+
+        //last values reported by the events, served by the getters so they need no platform call
+        struct WindowProperties
+        {
+            int32_t x;
+            int32_t y;
+            int32_t width;
+            int32_t height;
+            int32_t framebufferWidth;
+            int32_t framebufferHeight;
+            float xScale;
+            float yScale;
+            double cursorX; //only tracked while the cursor is over the window
+            double cursorY;
+            bool focused;
+            bool hovered;
+        } m_Properties = {};
+
+        //changes collected between BeginUpdate and Commit
+        struct WindowUpdate
+        {
+            WindowProperty changed;
+            int32_t x;
+            int32_t y;
+            int32_t width;
+            int32_t height;
+            bool decorated;
+            bool floating;
+            Monitor* monitor;
+            int32_t refreshRate;
+        } m_Update = {};
+        int32_t m_UpdateDepth = 0;
+        bool m_Committing = false; //size and position callbacks wait until the commit is applied
 
+        uint32_t m_Id = 0; //slot in Platform::s_WindowSlots
         VideoMode m_VideoMode = {};
         Monitor* m_Monitor = nullptr;
         Cursor* m_Cursor = nullptr;
         Context* m_Context = nullptr;
+        InputActionMap* m_InputActions = nullptr;
 
         struct WindowCallbacks
         {
@@ -143,6 +199,9 @@ namespace cpp_glfw
             WindowCharCallback character;
             WindowCharModsCallback characterMods;
             WindowDropCallback drop;
+            WindowDropPayloadCallback dropPayload;
+            WindowTextCallback text;
+            WindowTextModsCallback textMods;
         } m_Callbacks = {};
 
     protected:
@@ -161,6 +220,7 @@ namespace cpp_glfw
         friend class Platform;
         friend class Context;
         friend class EglContext;
+        friend class InputActionMap;
 
     public: CPP_GLFW_PUBLIC_API
         bool IsMaximized() const;
@@ -190,7 +250,10 @@ namespace cpp_glfw
         KeyState GetGetMouseButton(MouseButton button);
         void GetCursorPosition(double* x, double* y);
         Context* GetContext();
+        InputActionMap* GetInputActionMap();
         void* GetNativeHandle() const;
+        uint32_t GetId() const;
+        void Refresh();
 
         void SetTitle(const std::string& title);
         void SetIcon(const std::vector<Image*>& images);
@@ -210,6 +273,11 @@ namespace cpp_glfw
         void SetMonitor(Monitor* monitor, int32_t x, int32_t y, int32_t width, int32_t height, int32_t refreshRate);
         void SetInputMode(InputMode mode, int32_t value);
         void SetCursorPosition(double x, double y);
+        void SetInputActionMap(InputActionMap* map);
+        void SetDropBatchSize(uint32_t size);
+
+        void BeginUpdate();
+        void Commit();
 
         void Maximize();
         void Minimize();
@@ -238,9 +306,9 @@ namespace cpp_glfw
         void SetCursorEnterCallback(WindowCursorEnterCallback callback);
         void SetScrollCallback(WindowScrollCallback callback);
         void SetDropCallback(WindowDropCallback callback);
-
-    protected: CPP_GLFW_UTILS
-        const Image* ChooseImage(const std::vector<Image*>& images, int32_t width, int32_t height);
+        void SetDropPayloadCallback(WindowDropPayloadCallback callback);
+        void SetTextCallback(WindowTextCallback callback);
+        void SetTextModsCallback(WindowTextModsCallback callback);
 
     protected: CPP_GLFW_PLATFORM_API
         virtual bool PlatformIsMaximized() const = 0;
@@ -272,6 +340,7 @@ namespace cpp_glfw
         virtual void PlatformSetResizable(bool value) = 0;
         virtual void PlatformSetMousePassThrough(bool value) = 0;
         virtual void PlatformSetMonitor(Monitor* monitor, int32_t x, int32_t y, int32_t width, int32_t height, int32_t refreshRate) = 0;
+        virtual void PlatformCommit(WindowProperty changed, int32_t x, int32_t y, int32_t width, int32_t height) = 0;
         virtual void PlatformSetCursor(Cursor* cursor) = 0;
         virtual void PlatformSetCursorPosition(double x, double y) = 0;
         virtual void PlatformSetCursorMode(CursorMode mode) = 0;
@@ -302,6 +371,7 @@ namespace cpp_glfw
         void OnKey(Key key, int32_t scancode, KeyState action, KeyMods mods);
         void OnChar(uint32_t codepoint, KeyMods mods, bool plain);
         void OnCharMods(uint32_t codepoint, KeyMods mods);
-        void OnDrop(uint32_t count, const char** paths);
+        void OnTextInput();
+        void OnDrop(const DropPayload* payload);
     };
 }
@@ -118,12 +118,12 @@ int main(int argc, char **argv)
     {
         std::cout << "Current monitor: " << currentMonitor->GetName() << std::endl;
 
-        const std::vector<cpp_glfw::VideoMode *> &videoModes = currentMonitor->GetVideoModes();
+        const std::vector<cpp_glfw::VideoMode> &videoModes = currentMonitor->GetVideoModes();
 
         std::cout << "Video modes (" << videoModes.size() << "):" << std::endl;
         for (int32_t m = 0; m < videoModes.size(); m++)
         {
-            std::cout << "\t" << *videoModes[m] << std::endl;
+            std::cout << "\t" << videoModes[m] << std::endl;
         }
 
         cpp_glfw::VideoMode *currentVideoMode = currentMonitor->GetVideoMode();
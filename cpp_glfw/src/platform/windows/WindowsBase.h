@@ -68,6 +68,9 @@
 #ifndef WM_DPICHANGED
 #define WM_DPICHANGED 0x02E0
 #endif
+#ifndef WM_CLIPBOARDUPDATE
+#define WM_CLIPBOARDUPDATE 0x031D
+#endif
 #ifndef GET_XBUTTON_WPARAM
 #define GET_XBUTTON_WPARAM(w) (HIWORD(w))
 #endif
@@ -177,8 +180,8 @@ typedef enum
 
 #define CPP_GLFW_WINDOW_CLASS L"CPP_GLFW_WINDOW_CLASS"
 #define CPP_GLFW_HELPER_WINDOW_TITLE L"CPP_GLFW_HELPER_WINDOW"
-#define CPP_GLFW_WINDOW_PROP L"CPP_GLFW_WINDOW"
 #define CPP_GLFW_ICON L"CPP_GLFW_ICON"
+#define CPP_GLFW_CURSOR_TIMER 1
 
 // xinput.dll function pointer typedefs
 typedef DWORD(WINAPI* PFN_XInputGetCapabilities)(DWORD, DWORD, XINPUT_CAPABILITIES*);
@@ -189,6 +192,8 @@ typedef HRESULT(WINAPI* PFN_DirectInput8Create)(HINSTANCE, DWORD, REFIID, LPVOID
 
 // winmm.dll function pointer typedefs
 typedef DWORD(WINAPI* PFN_timeGetTime)(void);
+typedef UINT(WINAPI* PFN_timeBeginPeriod)(UINT);
+typedef UINT(WINAPI* PFN_timeEndPeriod)(UINT);
 
 // user32.dll function pointer typedefs
 typedef BOOL(WINAPI* PFN_SetProcessDPIAware)(void);
@@ -197,6 +202,9 @@ typedef BOOL(WINAPI* PFN_EnableNonClientDpiScaling)(HWND);
 typedef BOOL(WINAPI* PFN_SetProcessDpiAwarenessContext)(HANDLE);
 typedef UINT(WINAPI* PFN_GetDpiForWindow)(HWND);
 typedef BOOL(WINAPI* PFN_AdjustWindowRectExForDpi)(LPRECT, DWORD, BOOL, DWORD, UINT);
+typedef int(WINAPI* PFN_GetSystemMetricsForDpi)(int, UINT);
+typedef BOOL(WINAPI* PFN_AddClipboardFormatListener)(HWND);
+typedef BOOL(WINAPI* PFN_RemoveClipboardFormatListener)(HWND);
 
 // dwmapi.dll function pointer typedefs
 typedef HRESULT(WINAPI* PFN_DwmIsCompositionEnabled)(BOOL*);
@@ -0,0 +1,407 @@
+#include "platform/windows/WindowsPlatform.h"
+
+namespace cpp_glfw
+{
+    ////////////////////////////////////// STATIC INIT ///////////////////////////////////////////
+
+    std::thread WindowsClipboard::s_Thread = {};
+    std::mutex WindowsClipboard::s_Mutex = {};
+    std::mutex WindowsClipboard::s_OpenMutex = {};
+    std::condition_variable WindowsClipboard::s_Queued = {};
+    std::deque<WindowsClipboard::ClipboardRequest*> WindowsClipboard::s_Pending = {};
+    std::vector<WindowsClipboard::ClipboardRequest*> WindowsClipboard::s_Completed = {};
+    bool WindowsClipboard::s_Stop = false;
+    WindowsClipboard::ClipboardOffer WindowsClipboard::s_Offer = {};
+    UINT WindowsClipboard::s_HtmlFormat = 0;
+    UINT WindowsClipboard::s_PngFormat = 0;
+
+
+
+    ////////////////////////////////////// INTERNAL API ///////////////////////////////////////
+
+    /// <summary> Queues a read for the worker thread, the callback is called from a later PollEvents </summary>
+    bool WindowsClipboard::RequestData(const char* mimeType, ClipboardDataCallback callback, void* user)
+    {
+        ClipboardRequest* request = new ClipboardRequest();
+        if (!request)
+        {
+            return false;
+        }
+
+        request->mimeType = mimeType;
+        request->format = GetFormat(request->mimeType);
+        request->callback = callback;
+        request->user = user;
+        request->succeeded = false;
+        request->local = false;
+
+        if (!request->format)
+        {
+            CPP_GLFW_ERROR_WIN32("Failed to register clipboard format for %s!", mimeType);
+            delete request;
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(s_Mutex);
+
+        //the worker only starts once someone reads the clipboard asynchronously
+        if (!s_Thread.joinable())
+        {
+            s_Stop = false;
+            s_Thread = std::thread(Run);
+        }
+
+        s_Pending.push_back(request);
+        s_Queued.notify_one();
+
+        return true;
+    }
+
+    /// <summary> Announces the formats without any data, the provider is only called when someone pastes one of them </summary>
+    bool WindowsClipboard::OfferData(const std::vector<std::string>& mimeTypes, ClipboardProviderCallback provider, void* user)
+    {
+        std::vector<UINT> formats(mimeTypes.size());
+        for (size_t i = 0; i < mimeTypes.size(); i++)
+        {
+            formats[i] = GetFormat(mimeTypes[i]);
+            if (!formats[i])
+            {
+                CPP_GLFW_ERROR_WIN32("Failed to register clipboard format for %s!", mimeTypes[i].c_str());
+                return false;
+            }
+        }
+
+        if (!Open(WindowsPlatform::s_HelperWindowHandle))
+        {
+            CPP_GLFW_ERROR_WIN32("Failed to open clipboard!");
+            return false;
+        }
+
+        //emptying sends WM_DESTROYCLIPBOARD to the previous owner, which may be us, so the offer is replaced after it
+        EmptyClipboard();
+
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            s_Offer.mimeTypes = mimeTypes;
+            s_Offer.formats = formats;
+            s_Offer.provider = provider;
+            s_Offer.user = user;
+        }
+
+        for (UINT format : formats)
+        {
+            SetClipboardData(format, NULL);
+        }
+
+        Close();
+        return true;
+    }
+
+    void WindowsClipboard::DispatchCompleted()
+    {
+        std::vector<ClipboardRequest*> completed;
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            if (s_Completed.empty())
+            {
+                return;
+            }
+            completed.swap(s_Completed);
+        }
+
+        for (ClipboardRequest* request : completed)
+        {
+            if (request->local)
+            {
+                request->succeeded = ReadOffer(request->mimeType, &request->data);
+            }
+
+            //an empty payload still gets a valid pointer, nullptr means the type was not available
+            if (request->callback)
+            {
+                request->callback(request->mimeType.c_str(),
+                    request->succeeded ? (request->data.empty() ? (const uint8_t*)"" : request->data.data()) : nullptr,
+                    request->succeeded ? request->data.size() : 0,
+                    request->user);
+            }
+
+            delete request;
+        }
+    }
+
+    /// <summary> Requests that were not completed yet are dropped without calling their callbacks </summary>
+    void WindowsClipboard::Terminate()
+    {
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            s_Stop = true;
+            s_Queued.notify_one();
+        }
+
+        if (s_Thread.joinable())
+        {
+            s_Thread.join();
+        }
+
+        for (ClipboardRequest* request : s_Pending)
+        {
+            delete request;
+        }
+        for (ClipboardRequest* request : s_Completed)
+        {
+            delete request;
+        }
+
+        s_Pending.clear();
+        s_Completed.clear();
+    }
+
+    /// <summary> Waits for a read of the worker and retries for a moment while another application holds the clipboard </summary>
+    bool WindowsClipboard::Open(HWND owner)
+    {
+        s_OpenMutex.lock();
+
+        for (int32_t attempt = 0; attempt < 10; attempt++)
+        {
+            if (OpenClipboard(owner))
+            {
+                return true;
+            }
+            Sleep(5);
+        }
+
+        s_OpenMutex.unlock();
+        return false;
+    }
+
+    void WindowsClipboard::Close()
+    {
+        CloseClipboard();
+        s_OpenMutex.unlock();
+    }
+
+
+    /// <summary> WM_RENDERFORMAT, the clipboard is already opened by the application that pastes </summary>
+    void WindowsClipboard::Render(UINT format)
+    {
+        for (size_t i = 0; i < s_Offer.formats.size(); i++)
+        {
+            if (s_Offer.formats[i] != format)
+            {
+                continue;
+            }
+
+            std::vector<uint8_t> data;
+            if (!ReadOffer(s_Offer.mimeTypes[i], &data))
+            {
+                return;
+            }
+
+            HGLOBAL object = Encode(format, data);
+            if (object
+                && !SetClipboardData(format, object))
+            {
+                CPP_GLFW_ERROR_WIN32("Failed to set clipboard data!");
+                GlobalFree(object);
+            }
+            return;
+        }
+    }
+
+    /// <summary> WM_RENDERALLFORMATS, sent before the helper window is destroyed so the offer outlives the process </summary>
+    void WindowsClipboard::RenderAll()
+    {
+        if (!Open(WindowsPlatform::s_HelperWindowHandle))
+        {
+            return;
+        }
+
+        //another application may have taken the clipboard since the message was posted
+        if (GetClipboardOwner() == WindowsPlatform::s_HelperWindowHandle)
+        {
+            for (UINT format : s_Offer.formats)
+            {
+                Render(format);
+            }
+        }
+
+        Close();
+    }
+
+    /// <summary> WM_DESTROYCLIPBOARD, the offer is no longer on the clipboard </summary>
+    void WindowsClipboard::Release()
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        s_Offer = {};
+    }
+
+
+
+    ///////////////////////////////////////// UTILS ///////////////////////////////////////////
+
+    UINT WindowsClipboard::GetFormat(const std::string& mimeType)
+    {
+        if (mimeType == "text/plain"
+            || mimeType == "text/plain;charset=utf-8")
+        {
+            return CF_UNICODETEXT;
+        }
+
+        if (mimeType == "text/html")
+        {
+            if (!s_HtmlFormat)
+            {
+                s_HtmlFormat = RegisterClipboardFormatW(L"HTML Format");
+            }
+            return s_HtmlFormat;
+        }
+
+        if (mimeType == "image/png")
+        {
+            if (!s_PngFormat)
+            {
+                s_PngFormat = RegisterClipboardFormatW(L"PNG");
+            }
+            return s_PngFormat;
+        }
+
+        //registering an existing name returns the same format, so other applications using the type name interoperate
+        WCHAR* name = WindowsPlatform::UTF8ToWideString(mimeType.c_str());
+        if (!name)
+        {
+            return 0;
+        }
+
+        UINT format = RegisterClipboardFormatW(name);
+        Memory::Free(name);
+
+        return format;
+    }
+
+    void WindowsClipboard::Run()
+    {
+        std::unique_lock<std::mutex> lock(s_Mutex);
+
+        while (true)
+        {
+            s_Queued.wait(lock, [] { return s_Stop || !s_Pending.empty(); });
+
+            if (s_Stop)
+            {
+                return;
+            }
+
+            ClipboardRequest* request = s_Pending.front();
+            s_Pending.pop_front();
+
+            //the copy can be large, so it happens without holding the lock
+            lock.unlock();
+            Read(request);
+            lock.lock();
+
+            s_Completed.push_back(request);
+        }
+    }
+
+    /// <summary> Runs on the worker thread, so a slow delayed render of another application only blocks the worker </summary>
+    void WindowsClipboard::Read(ClipboardRequest* request)
+    {
+        if (!Open(NULL))
+        {
+            return;
+        }
+
+        //our own delayed render would be sent to the event thread, so it is read there instead,
+        //data set directly by the helper window, like SetClipboardString, is read as usual
+        if (GetClipboardOwner() == WindowsPlatform::s_HelperWindowHandle
+            && IsOffered(request->format))
+        {
+            request->local = true;
+            Close();
+            return;
+        }
+
+        HANDLE object = GetClipboardData(request->format);
+        const uint8_t* buffer = object ? (const uint8_t*)GlobalLock(object) : nullptr;
+
+        if (buffer)
+        {
+            const size_t size = GlobalSize(object);
+
+            if (request->format == CF_UNICODETEXT)
+            {
+                const WCHAR* text = (const WCHAR*)buffer;
+                const int32_t length = (int32_t)wcsnlen(text, size / sizeof(WCHAR));
+                const int32_t count = WideCharToMultiByte(CP_UTF8, 0, text, length, NULL, 0, NULL, NULL);
+
+                request->data.resize(count);
+                WideCharToMultiByte(CP_UTF8, 0, text, length, (char*)request->data.data(), count, NULL, NULL);
+            }
+            else
+            {
+                request->data.assign(buffer, buffer + size);
+            }
+
+            request->succeeded = true;
+            GlobalUnlock(object);
+        }
+
+        Close();
+    }
+
+    bool WindowsClipboard::IsOffered(UINT format)
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        return std::find(s_Offer.formats.begin(), s_Offer.formats.end(), format) != s_Offer.formats.end();
+    }
+
+    bool WindowsClipboard::ReadOffer(const std::string& mimeType, std::vector<uint8_t>* data)
+    {
+        for (const std::string& offered : s_Offer.mimeTypes)
+        {
+            if (offered == mimeType)
+            {
+                return s_Offer.provider(mimeType.c_str(), data, s_Offer.user);
+            }
+        }
+        return false;
+    }
+
+    /// <summary> Text is given as UTF-8 and stored as terminated UTF-16, every other format is stored as it is </summary>
+    HGLOBAL WindowsClipboard::Encode(UINT format, const std::vector<uint8_t>& data)
+    {
+        if (format == CF_UNICODETEXT)
+        {
+            const int32_t count = MultiByteToWideChar(CP_UTF8, 0, (const char*)data.data(), (int32_t)data.size(), NULL, 0);
+
+            HGLOBAL object = GlobalAlloc(GMEM_MOVEABLE, (count + 1) * sizeof(WCHAR));
+            if (!object)
+            {
+                CPP_GLFW_ERROR_WIN32("Failed to allocate global handle for clipboard!");
+                return nullptr;
+            }
+
+            WCHAR* buffer = (WCHAR*)GlobalLock(object);
+            MultiByteToWideChar(CP_UTF8, 0, (const char*)data.data(), (int32_t)data.size(), buffer, count);
+            buffer[count] = 0;
+            GlobalUnlock(object);
+
+            return object;
+        }
+
+        HGLOBAL object = GlobalAlloc(GMEM_MOVEABLE, std::max(data.size(), (size_t)1));
+        if (!object)
+        {
+            CPP_GLFW_ERROR_WIN32("Failed to allocate global handle for clipboard!");
+            return nullptr;
+        }
+
+        if (!data.empty())
+        {
+            memcpy(GlobalLock(object), data.data(), data.size());
+            GlobalUnlock(object);
+        }
+
+        return object;
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "platform/windows/WindowsBase.h"
+#include "engine/core/Platform.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+namespace cpp_glfw
+{
+    /// <summary>
+    /// Reads clipboard formats on a worker thread and serves offered formats through delayed rendering.
+    /// Completed reads are handed back to the event thread at the end of PollEvents, so callbacks never run on the worker.
+    /// MIME types map to the standard formats where one exists, any other type is used as a registered format name.
+    /// </summary>
+    class WindowsClipboard
+    {
+    protected:
+        struct ClipboardRequest
+        {
+            CPP_GLFW_MEMORY_TAG(MemoryTag::Clipboard)
+
+            std::string mimeType;
+            UINT format;
+            ClipboardDataCallback callback;
+            void* user;
+            std::vector<uint8_t> data;
+            bool succeeded;
+            bool local; //the format is an unrendered offer of the helper window, so it is read on the event thread
+        };
+
+        struct ClipboardOffer
+        {
+            std::vector<std::string> mimeTypes;
+            std::vector<UINT> formats;
+            ClipboardProviderCallback provider;
+            void* user;
+        };
+
+    protected:
+        static std::thread s_Thread;
+        static std::mutex s_Mutex; //guards the queues and the offered formats read by the worker
+        static std::mutex s_OpenMutex; //held while the clipboard is open, so the worker and the event thread take turns
+        static std::condition_variable s_Queued;
+        static std::deque<ClipboardRequest*> s_Pending;
+        static std::vector<ClipboardRequest*> s_Completed;
+        static bool s_Stop;
+        static ClipboardOffer s_Offer;
+        static UINT s_HtmlFormat;
+        static UINT s_PngFormat;
+
+    public: CPP_GLFW_INTERNAL_API
+        static bool RequestData(const char* mimeType, ClipboardDataCallback callback, void* user);
+        static bool OfferData(const std::vector<std::string>& mimeTypes, ClipboardProviderCallback provider, void* user);
+        static void DispatchCompleted();
+        static void Terminate();
+
+        static bool Open(HWND owner);
+        static void Close();
+
+        static void Render(UINT format);
+        static void RenderAll();
+        static void Release();
+
+    protected: CPP_GLFW_UTILS
+        static UINT GetFormat(const std::string& mimeType);
+        static void Run();
+        static void Read(ClipboardRequest* request);
+        static bool IsOffered(UINT format);
+        static bool ReadOffer(const std::string& mimeType, std::vector<uint8_t>* data);
+        static HGLOBAL Encode(UINT format, const std::vector<uint8_t>& data);
+    };
+}
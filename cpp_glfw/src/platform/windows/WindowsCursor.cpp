@@ -2,6 +2,12 @@
 
 namespace cpp_glfw
 {
+    ////////////////////////////////////// STATIC INIT ///////////////////////////////////////////
+
+    std::vector<WindowsCursor*> WindowsCursor::s_AnimatedCursors = {};
+
+
+
     Cursor* Cursor::Create(const Image* image, int32_t xHot, int32_t yHot)
     {
         HCURSOR cursorHandle = (HCURSOR)WindowsWindow::CreateIcon(image, xHot, yHot, false);
@@ -11,6 +17,12 @@ namespace cpp_glfw
         }
 
         WindowsCursor* cursor = new WindowsCursor();
+        if (!cursor)
+        {
+            DestroyIcon((HICON)cursorHandle);
+            return nullptr;
+        }
+
         cursor->m_Handle = cursorHandle;
 
         return cursor;
@@ -50,7 +62,55 @@ namespace cpp_glfw
         }
 
         WindowsCursor* cursor = new WindowsCursor();
+        if (!cursor)
+        {
+            return nullptr;
+        }
+
         cursor->m_Handle = cursorHandle;
+        cursor->m_Shared = true;
+
+        return cursor;
+    }
+
+
+    Cursor* Cursor::Create(const std::vector<Image*>& images, const std::vector<double>& durations, int32_t xHot, int32_t yHot)
+    {
+        WindowsCursor* cursor = new WindowsCursor();
+        if (!cursor)
+        {
+            return nullptr;
+        }
+
+        cursor->m_Frames.reserve(images.size());
+        cursor->m_FrameEnds.reserve(images.size());
+
+        const double frequency = (double)Platform::GetTimerFrequency();
+        double end = 0.0;
+
+        for (size_t i = 0; i < images.size(); i++)
+        {
+            WindowsCursor* frame = (WindowsCursor*)Cursor::Create(images[i], xHot, yHot);
+            if (!frame)
+            {
+                delete cursor;
+                return nullptr;
+            }
+
+            //the ends are accumulated in seconds so rounding does not add up over the frames
+            end += durations[i];
+
+            cursor->m_Frames.push_back(frame);
+            cursor->m_FrameEnds.push_back(std::max((uint64_t)(end * frequency), (uint64_t)i + 1));
+        }
+
+        cursor->m_Handle = cursor->m_Frames[0]->m_Handle;
+        cursor->m_Shared = true;
+        cursor->m_Start = Platform::GetTimerValue();
+
+        s_AnimatedCursors.push_back(cursor);
+
+        Animate();
 
         return cursor;
     }
@@ -62,9 +122,98 @@ namespace cpp_glfw
 
     WindowsCursor::~WindowsCursor()
     {
-        if (m_Handle)
+        if (m_Handle
+            && !m_Shared)
         {
             DestroyIcon((HICON)m_Handle);
         }
+
+        if (!m_Frames.empty())
+        {
+            for (WindowsCursor* frame : m_Frames)
+            {
+                delete frame;
+            }
+
+            auto it = std::find(s_AnimatedCursors.begin(), s_AnimatedCursors.end(), this);
+            if (it != s_AnimatedCursors.end())
+            {
+                s_AnimatedCursors.erase(it);
+            }
+
+            Animate();
+        }
+    }
+
+
+
+    /////////////////////////////////////// INTERNAL API ////////////////////////////////////////
+
+    /// <summary>
+    /// Called from the helper window on WM_TIMER, so frames advance on the thread that processes events.
+    /// The frame is picked from the timer value instead of counting ticks, so a late WM_TIMER never makes the animation drift,
+    /// and the timer is re-armed for the nearest frame change of any cursor that is set on a window.
+    /// </summary>
+    void WindowsCursor::Animate()
+    {
+        const uint64_t now = Platform::GetTimerValue();
+        const uint64_t frequency = Platform::GetTimerFrequency();
+
+        uint64_t wait = UINT64_MAX;
+        bool changed = false;
+
+        for (WindowsCursor* cursor : s_AnimatedCursors)
+        {
+            const uint64_t elapsed = (now - cursor->m_Start) % cursor->m_FrameEnds.back();
+            const size_t frame = std::upper_bound(cursor->m_FrameEnds.begin(), cursor->m_FrameEnds.end(), elapsed) - cursor->m_FrameEnds.begin();
+
+            if (frame != cursor->m_Frame)
+            {
+                cursor->m_Frame = frame;
+                cursor->m_Handle = cursor->m_Frames[frame]->m_Handle;
+                changed |= cursor->m_WindowCount > 0;
+            }
+
+            if (cursor->m_WindowCount > 0
+                && cursor->m_Frames.size() > 1)
+            {
+                wait = std::min(wait, cursor->m_FrameEnds[frame] - elapsed);
+            }
+        }
+
+        //only the window under the pointer shows a cursor, so it is the only one that needs updating
+        if (changed)
+        {
+            POINT pos;
+            if (GetCursorPos(&pos))
+            {
+                HWND handle = WindowFromPoint(pos);
+                WindowsWindow* window = handle ? WindowsPlatform::GetWindowFromHandle(handle) : nullptr;
+
+                if (window
+                    && window->m_Cursor
+                    && !((WindowsCursor*)window->m_Cursor)->m_Frames.empty()
+                    && window->IsCursorInContentArea())
+                {
+                    window->UpdateCursorImage();
+                }
+            }
+        }
+
+        if (!WindowsPlatform::s_HelperWindowHandle)
+        {
+            return;
+        }
+
+        if (wait == UINT64_MAX)
+        {
+            KillTimer(WindowsPlatform::s_HelperWindowHandle, CPP_GLFW_CURSOR_TIMER);
+            return;
+        }
+
+        //round up so the timer does not fire just before the frame change
+        const uint64_t delay = (wait * 1000 + frequency - 1) / frequency;
+        SetTimer(WindowsPlatform::s_HelperWindowHandle, CPP_GLFW_CURSOR_TIMER,
+            (UINT)std::max(std::min(delay, (uint64_t)USER_TIMER_MAXIMUM), (uint64_t)USER_TIMER_MINIMUM), NULL);
     }
 }
@@ -9,9 +9,22 @@ namespace cpp_glfw
     {
     public:
         HCURSOR m_Handle = nullptr;
+        bool m_Shared = false; //loaded with LR_SHARED or borrowed from a frame, not destroyed with the cursor
+
+        //animated cursors point m_Handle at the handle of the current frame
+        std::vector<WindowsCursor*> m_Frames;
+        std::vector<uint64_t> m_FrameEnds; //timer ticks from the start of the loop to the end of each frame
+        uint64_t m_Start = 0;
+        size_t m_Frame = 0;
+
+    protected:
+        static std::vector<WindowsCursor*> s_AnimatedCursors;
 
     public:
         WindowsCursor();
         virtual ~WindowsCursor();
+
+    public: CPP_GLFW_INTERNAL_API
+        static void Animate();
     };
 }
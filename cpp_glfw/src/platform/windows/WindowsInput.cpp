@@ -4,12 +4,11 @@ namespace cpp_glfw
 {
     bool Input::PlatformInitJoystycks()
     {
-
-        return false;
+        return WindowsJoystick::StartPolling();
     }
 
     void Input::PlatformTerminateJoystycks()
     {
-
+        WindowsJoystick::StopPolling();
     }
 }
@@ -0,0 +1,224 @@
+#include "platform/windows/WindowsPlatform.h"
+
+namespace cpp_glfw
+{
+    ////////////////////////////////////// STATIC INIT ////////////////////////////////////////////
+
+    std::thread WindowsJoystick::s_PollThread = {};
+    HANDLE WindowsJoystick::s_StopEvent = nullptr;
+    std::atomic<bool> WindowsJoystick::s_RescanRequested = { true };
+    DWORD WindowsJoystick::s_PollInterval = 1;
+    DWORD WindowsJoystick::s_RescanInterval = 2000;
+
+
+
+    ////////////////////////////////////// INTERNAL API ///////////////////////////////////////
+
+    bool WindowsJoystick::StartPolling()
+    {
+        if (!WindowsPlatform::s_Libs.xInput.GetState
+            || !WindowsPlatform::s_Libs.xInput.GetCapabilities)
+        {
+            CPP_GLFW_ERROR("XInput is not available, joysticks are disabled!");
+            return false;
+        }
+
+        s_StopEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+        if (!s_StopEvent)
+        {
+            CPP_GLFW_ERROR_WIN32("Failed to create joystick polling stop event!");
+            return false;
+        }
+
+        s_RescanRequested = true;
+        s_PollThread = std::thread(PollThread);
+        return true;
+    }
+
+    void WindowsJoystick::StopPolling()
+    {
+        if (s_PollThread.joinable())
+        {
+            SetEvent(s_StopEvent);
+            s_PollThread.join();
+        }
+
+        if (s_StopEvent)
+        {
+            CloseHandle(s_StopEvent);
+            s_StopEvent = nullptr;
+        }
+    }
+
+    /// <summary> Called on device arrival or removal, empty slots are probed on the next poll </summary>
+    void WindowsJoystick::RequestRescan()
+    {
+        s_RescanRequested.store(true, std::memory_order_relaxed);
+    }
+
+
+
+    ///////////////////////////////////////// UTILS ///////////////////////////////////////////
+
+    void WindowsJoystick::PollThread()
+    {
+        XInputDevice devices[XUSER_MAX_COUNT] = {};
+        DWORD lastRescanTime = GetTickCount();
+
+        //without a finer timer resolution the wait below is rounded up to a system tick of about 15.6 ms
+        const bool periodSet = WindowsPlatform::s_Libs.winmm.BeginPeriod
+            && WindowsPlatform::s_Libs.winmm.EndPeriod
+            && WindowsPlatform::s_Libs.winmm.BeginPeriod(s_PollInterval) == 0;
+
+        do
+        {
+            bool rescan = s_RescanRequested.exchange(false, std::memory_order_relaxed);
+
+            const DWORD now = GetTickCount();
+            if (now - lastRescanTime >= s_RescanInterval)
+            {
+                rescan = true;
+            }
+
+            if (rescan)
+            {
+                lastRescanTime = now;
+            }
+
+            for (DWORD index = 0; index < XUSER_MAX_COUNT; index++)
+            {
+                //XInputGetState on an empty slot is very slow, so only probe them when devices may have changed
+                if (!devices[index].connected
+                    && !rescan)
+                {
+                    continue;
+                }
+
+                Joystick& joystick = Input::s_Joysticks[index];
+                if (PollXInput(index, &devices[index], joystick.GetBackSnapshot()))
+                {
+                    joystick.PublishSnapshot();
+                }
+            }
+        }
+        while (WaitForSingleObject(s_StopEvent, s_PollInterval) == WAIT_TIMEOUT);
+
+        if (periodSet)
+        {
+            WindowsPlatform::s_Libs.winmm.EndPeriod(s_PollInterval);
+        }
+    }
+
+    /// <summary> Returns true if the snapshot was filled in and should be published </summary>
+    bool WindowsJoystick::PollXInput(DWORD index, XInputDevice* device, JoystickSnapshot* snapshot)
+    {
+        XINPUT_STATE xis;
+        if (WindowsPlatform::s_Libs.xInput.GetState(index, &xis) != ERROR_SUCCESS)
+        {
+            if (!device->connected)
+            {
+                return false;
+            }
+
+            //the serial outlives the device, so the next one in this slot gets a new connection
+            const uint32_t connection = device->connection;
+            *device = {};
+            device->connection = connection;
+
+            memset(snapshot, 0, sizeof(JoystickSnapshot));
+            return true;
+        }
+
+        if (!device->connected)
+        {
+            XINPUT_CAPABILITIES xic;
+            if (WindowsPlatform::s_Libs.xInput.GetCapabilities(index, 0, &xic) != ERROR_SUCCESS)
+            {
+                return false;
+            }
+
+            device->connected = true;
+            device->connection++;
+            strncpy(device->name, GetXInputDeviceName(&xic), sizeof(device->name) - 1);
+            sprintf(device->guid, "78696e707574%02x000000000000000000", xic.SubType & 0xff);
+        }
+        else if (xis.dwPacketNumber == device->packet)
+        {
+            //nothing changed since the last published snapshot
+            return false;
+        }
+
+        device->packet = xis.dwPacketNumber;
+
+        snapshot->connected = true;
+        snapshot->connection = device->connection;
+        memcpy(snapshot->name, device->name, sizeof(snapshot->name));
+        memcpy(snapshot->guid, device->guid, sizeof(snapshot->guid));
+
+        snapshot->axisCount = 6;
+        snapshot->axes[0] = (xis.Gamepad.sThumbLX + 0.5f) / 32767.5f;
+        snapshot->axes[1] = -(xis.Gamepad.sThumbLY + 0.5f) / 32767.5f;
+        snapshot->axes[2] = (xis.Gamepad.sThumbRX + 0.5f) / 32767.5f;
+        snapshot->axes[3] = -(xis.Gamepad.sThumbRY + 0.5f) / 32767.5f;
+        snapshot->axes[4] = xis.Gamepad.bLeftTrigger / 127.5f - 1.0f;
+        snapshot->axes[5] = xis.Gamepad.bRightTrigger / 127.5f - 1.0f;
+
+        const WORD buttons[] =
+        {
+            XINPUT_GAMEPAD_A,
+            XINPUT_GAMEPAD_B,
+            XINPUT_GAMEPAD_X,
+            XINPUT_GAMEPAD_Y,
+            XINPUT_GAMEPAD_LEFT_SHOULDER,
+            XINPUT_GAMEPAD_RIGHT_SHOULDER,
+            XINPUT_GAMEPAD_BACK,
+            XINPUT_GAMEPAD_START,
+            XINPUT_GAMEPAD_LEFT_THUMB,
+            XINPUT_GAMEPAD_RIGHT_THUMB
+        };
+
+        snapshot->buttonCount = sizeof(buttons) / sizeof(buttons[0]);
+        for (int32_t i = 0; i < snapshot->buttonCount; i++)
+        {
+            snapshot->buttons[i] = (xis.Gamepad.wButtons & buttons[i]) ? 1 : 0;
+        }
+
+        HatState dpad = HatState::Centered;
+        if (xis.Gamepad.wButtons & XINPUT_GAMEPAD_DPAD_UP) dpad = dpad | HatState::Up;
+        if (xis.Gamepad.wButtons & XINPUT_GAMEPAD_DPAD_RIGHT) dpad = dpad | HatState::Right;
+        if (xis.Gamepad.wButtons & XINPUT_GAMEPAD_DPAD_DOWN) dpad = dpad | HatState::Down;
+        if (xis.Gamepad.wButtons & XINPUT_GAMEPAD_DPAD_LEFT) dpad = dpad | HatState::Left;
+
+        //treat opposing directions as cancelling each other out
+        if ((dpad & (HatState::Right | HatState::Left)) == (HatState::Right | HatState::Left)) dpad = dpad & ~(HatState::Right | HatState::Left);
+        if ((dpad & (HatState::Up | HatState::Down)) == (HatState::Up | HatState::Down)) dpad = dpad & ~(HatState::Up | HatState::Down);
+
+        snapshot->hatCount = 1;
+        snapshot->hats[0] = (uint8_t)dpad;
+
+        return true;
+    }
+
+    const char* WindowsJoystick::GetXInputDeviceName(const XINPUT_CAPABILITIES* capabilities)
+    {
+        switch (capabilities->SubType)
+        {
+            case XINPUT_DEVSUBTYPE_WHEEL:        return "XInput Wheel";
+            case XINPUT_DEVSUBTYPE_ARCADE_STICK: return "XInput Arcade Stick";
+            case XINPUT_DEVSUBTYPE_FLIGHT_STICK: return "XInput Flight Stick";
+            case XINPUT_DEVSUBTYPE_DANCE_PAD:    return "XInput Dance Pad";
+            case XINPUT_DEVSUBTYPE_GUITAR:       return "XInput Guitar";
+            case XINPUT_DEVSUBTYPE_DRUM_KIT:     return "XInput Drum Kit";
+            case XINPUT_DEVSUBTYPE_GAMEPAD:
+            {
+                if (capabilities->Flags & XINPUT_CAPS_WIRELESS)
+                {
+                    return "Wireless Xbox Controller";
+                }
+                return "Xbox Controller";
+            }
+        }
+
+        return "Unknown XInput Device";
+    }
+}
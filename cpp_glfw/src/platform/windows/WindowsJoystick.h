@@ -0,0 +1,43 @@
+#pragma once
+
+#include "platform/windows/WindowsBase.h"
+#include "engine/core/Joystick.h"
+
+#include <thread>
+
+namespace cpp_glfw
+{
+    /// <summary>
+    /// XInput backend. Devices are read on a dedicated polling thread which publishes
+    /// complete snapshots to the joysticks, so PollEvents never calls into XInput.
+    /// </summary>
+    class WindowsJoystick
+    {
+    public:
+        struct XInputDevice
+        {
+            bool connected;
+            uint32_t connection; //counts the devices seen in this slot
+            DWORD packet;
+            char name[128];
+            char guid[33];
+        };
+
+    public:
+        static std::thread s_PollThread;
+        static HANDLE s_StopEvent;
+        static std::atomic<bool> s_RescanRequested;
+        static DWORD s_PollInterval; //milliseconds between device reads, the timer resolution is raised to match while the thread runs
+        static DWORD s_RescanInterval; //milliseconds between scans of empty slots when no device notification arrives
+
+    public: CPP_GLFW_INTERNAL_API
+        static bool StartPolling();
+        static void StopPolling();
+        static void RequestRescan();
+
+    protected: CPP_GLFW_UTILS
+        static void PollThread();
+        static bool PollXInput(DWORD index, XInputDevice* device, JoystickSnapshot* snapshot);
+        static const char* GetXInputDeviceName(const XINPUT_CAPABILITIES* capabilities);
+    };
+}
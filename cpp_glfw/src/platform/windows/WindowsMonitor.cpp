@@ -50,6 +50,43 @@ namespace cpp_glfw
 
 
 
+    /// <summary> Hash of the names that identify a display output, stable across display changes </summary>
+    uint64_t WindowsMonitor::GetIdentity(const DISPLAY_DEVICEW* adapter, const DISPLAY_DEVICEW* display)
+    {
+        uint64_t hash = Utils::HashSeed;
+
+        for (const WCHAR* name : { adapter->DeviceName, display ? display->DeviceName : L"", display ? display->DeviceID : L"" })
+        {
+            hash = Utils::Hash(name, wcslen(name) * sizeof(WCHAR), hash);
+
+            //separator, so names that only differ in where they are split do not collide
+            hash = Utils::HashWord(0xffff, hash);
+        }
+
+        return hash;
+    }
+
+    void WindowsMonitor::RefreshHandle()
+    {
+        DEVMODEW dm = {};
+        dm.dmSize = sizeof(dm);
+        EnumDisplaySettingsW(m_AdapterName, ENUM_CURRENT_SETTINGS, &dm);
+
+        //only enumerate the monitors that intersect this one
+        RECT rect =
+        {
+            dm.dmPosition.x,
+            dm.dmPosition.y,
+            dm.dmPosition.x + (LONG)dm.dmPelsWidth,
+            dm.dmPosition.y + (LONG)dm.dmPelsHeight
+        };
+
+        m_Handle = nullptr;
+        EnumDisplayMonitors(nullptr, &rect, WindowsMonitor::SetHandle, (LPARAM)this);
+    }
+
+
+
     ////////////////////////////////////// CONSTRUCTOR ////////////////////////////////////////
 
     WindowsMonitor::WindowsMonitor(DISPLAY_DEVICEW* adapter, DISPLAY_DEVICEW* display)
@@ -62,6 +99,7 @@ namespace cpp_glfw
         if (display)
         {
             wcscpy(m_DisplayName, display->DeviceName);
+            wcsncpy(m_DeviceID, display->DeviceID, sizeof(m_DeviceID) / sizeof(WCHAR) - 1);
             WindowsPlatform::WideStringToUTF8(display->DeviceName, m_PublicDisplayName);
         }
 
@@ -90,16 +128,7 @@ namespace cpp_glfw
         DeleteDC(dc);
 
         //set handle
-        RECT rect =
-        {
-            dm.dmPosition.x,
-            dm.dmPosition.y,
-            dm.dmPosition.x + dm.dmPelsWidth,
-            dm.dmPosition.y + dm.dmPelsHeight
-        };
-
-        m_Handle = nullptr;
-        EnumDisplayMonitors(nullptr, &rect, WindowsMonitor::SetHandle, (LPARAM)this);
+        RefreshHandle();
     }
 
     WindowsMonitor::~WindowsMonitor()
@@ -158,7 +187,7 @@ namespace cpp_glfw
     }
 
 
-    void WindowsMonitor::PlatformGetVideoModes(std::vector<VideoMode*>& videoModes)
+    void WindowsMonitor::PlatformGetVideoModes(std::vector<VideoMode>& videoModes)
     {
         int32_t videoModeIndex = 0;
 
@@ -180,55 +209,46 @@ namespace cpp_glfw
                 continue;
             }
 
-            int32_t redBits, greenBits, blueBits;
-            Monitor::SplitBPP(dm.dmBitsPerPel, &redBits, &greenBits, &blueBits);
+            VideoMode videoMode;
+            videoMode.width = dm.dmPelsWidth;
+            videoMode.height = dm.dmPelsHeight;
+            videoMode.refreshRate = dm.dmDisplayFrequency;
+            Monitor::SplitBPP(dm.dmBitsPerPel, &videoMode.redBits, &videoMode.greenBits, &videoMode.blueBits);
+
+            videoModes.push_back(videoMode);
+        }
+
+        //drop duplicates before testing, the same mode is usually enumerated once per orientation and scaling
+        Monitor::SortVideoModes(videoModes);
 
-            //skip duplicate modes
-            int32_t i;
-            for (i = 0; i < m_VideoModes.size(); i++)
+        //skip modes not supported by the connected displays
+        if (m_ModesPruned)
+        {
+            videoModes.erase(std::remove_if(videoModes.begin(), videoModes.end(), [this](const VideoMode& videoMode)
             {
-                VideoMode existingVideoMode = *m_VideoModes[i];
-
-                if (existingVideoMode.width == dm.dmPelsWidth
-                    && existingVideoMode.height == dm.dmPelsHeight
-                    && existingVideoMode.refreshRate == dm.dmDisplayFrequency
-                    && existingVideoMode.redBits == redBits
-                    && existingVideoMode.greenBits == greenBits
-                    && existingVideoMode.blueBits == blueBits)
+                DEVMODEW dm = {};
+                dm.dmSize = sizeof(dm);
+                dm.dmFields = DM_PELSWIDTH | DM_PELSHEIGHT | DM_BITSPERPEL | DM_DISPLAYFREQUENCY;
+                dm.dmPelsWidth = videoMode.width;
+                dm.dmPelsHeight = videoMode.height;
+                dm.dmBitsPerPel = videoMode.redBits + videoMode.greenBits + videoMode.blueBits;
+                dm.dmDisplayFrequency = videoMode.refreshRate;
+
+                if (dm.dmBitsPerPel >= 24)
                 {
-                    break;
+                    dm.dmBitsPerPel = 32;
                 }
-            }
-            if (i < m_VideoModes.size())
-            {
-                continue;
-            }
-
-            //skip modes not supported by the connected displays
-            if (m_ModesPruned
-                && (ChangeDisplaySettingsExW(m_AdapterName, &dm, NULL, CDS_TEST, NULL) != DISP_CHANGE_SUCCESSFUL))
-            {
-                continue;
-            }
 
-            //add a new video mode
-            VideoMode* videoMode = new VideoMode();
-            videoMode->width = dm.dmPelsWidth;
-            videoMode->height = dm.dmPelsHeight;
-            videoMode->refreshRate = dm.dmDisplayFrequency;
-            videoMode->redBits = redBits;
-            videoMode->greenBits = greenBits;
-            videoMode->blueBits = blueBits;
-
-            m_VideoModes.push_back(videoMode);
+                return ChangeDisplaySettingsExW(m_AdapterName, &dm, NULL, CDS_TEST, NULL) != DISP_CHANGE_SUCCESSFUL;
+            }), videoModes.end());
         }
 
         //if no valid modes were found, add the current mode
-        if (!m_VideoModes.size())
+        if (!videoModes.size())
         {
-            VideoMode* videoMode = new VideoMode();
-            PlatformGetVideoMode(videoMode);
-            m_VideoModes.push_back(videoMode);
+            VideoMode videoMode;
+            PlatformGetVideoMode(&videoMode);
+            videoModes.push_back(videoMode);
         }
     }
 
@@ -251,7 +271,8 @@ namespace cpp_glfw
         const VideoMode* closestVideoMode = GetClosestVideoMode(videoMode);
         VideoMode* currentVideoMode = GetVideoMode();
 
-        if (*currentVideoMode == *closestVideoMode)
+        if (!closestVideoMode
+            || *currentVideoMode == *closestVideoMode)
         {
             return;
         }
@@ -299,7 +320,7 @@ namespace cpp_glfw
     }
 
 
-    bool WindowsMonitor::PlatformGetGammaRamp(GammaRamp* ramp)
+    bool WindowsMonitor::PlatformGetGammaRamp(MonitorGammaRamp* ramp)
     {
         HDC dc = CreateDCW(L"DISPLAY", m_AdapterName, NULL, NULL);
 
@@ -308,20 +329,16 @@ namespace cpp_glfw
 
         DeleteDC(dc);
 
-        ramp->Clear();
-        ramp->size = 256;
+        ramp->Resize(256);
 
-        for (int i = 0; i < 256; i++)
-        {
-            ramp->red.push_back(values[0][i]);
-            ramp->green.push_back(values[1][i]);
-            ramp->blue.push_back(values[2][i]);
-        }
+        memcpy(ramp->red.data(), values[0], sizeof(values[0]));
+        memcpy(ramp->green.data(), values[1], sizeof(values[1]));
+        memcpy(ramp->blue.data(), values[2], sizeof(values[2]));
 
         return true;
     }
 
-    void WindowsMonitor::PlatformSetGammaRamp(const GammaRamp* ramp)
+    void WindowsMonitor::PlatformSetGammaRamp(const MonitorGammaRamp* ramp)
     {
         WORD values[3][256];
 
@@ -331,15 +348,74 @@ namespace cpp_glfw
             return;
         }
 
-        for (int i = 0; i < 256; i++)
-        {
-            values[0][i] = ramp->red[i];
-            values[1][i] = ramp->green[i];
-            values[2][i] = ramp->blue[i];
-        }
+        memcpy(values[0], ramp->red.data(), sizeof(values[0]));
+        memcpy(values[1], ramp->green.data(), sizeof(values[1]));
+        memcpy(values[2], ramp->blue.data(), sizeof(values[2]));
 
         HDC dc = CreateDCW(L"DISPLAY", m_AdapterName, NULL, NULL);
         SetDeviceGammaRamp(dc, values);
         DeleteDC(dc);
     }
+
+
+    /// <summary>
+    /// Reads the EDID the monitor driver stored in the registry.
+    /// The device id is MONITOR\model\driver, the EDID is under the DISPLAY\model instance whose Driver value matches.
+    /// </summary>
+    bool WindowsMonitor::PlatformGetEdid(std::vector<uint8_t>& data)
+    {
+        const WCHAR* model = wcschr(m_DeviceID, L'\\');
+        const WCHAR* driver = model ? wcschr(model + 1, L'\\') : nullptr;
+
+        if (!driver)
+        {
+            return false;
+        }
+
+        WCHAR path[256];
+        swprintf(path, sizeof(path) / sizeof(WCHAR), L"SYSTEM\\CurrentControlSet\\Enum\\DISPLAY\\%.*ls", (int)(driver - model - 1), model + 1);
+
+        HKEY modelKey;
+        if (RegOpenKeyExW(HKEY_LOCAL_MACHINE, path, 0, KEY_READ, &modelKey) != ERROR_SUCCESS)
+        {
+            return false;
+        }
+
+        bool found = false;
+
+        for (DWORD index = 0; !found; index++)
+        {
+            WCHAR instance[128];
+            DWORD instanceLength = sizeof(instance) / sizeof(WCHAR);
+
+            if (RegEnumKeyExW(modelKey, index, instance, &instanceLength, NULL, NULL, NULL, NULL) != ERROR_SUCCESS)
+            {
+                break;
+            }
+
+            WCHAR instanceDriver[128] = {};
+            DWORD instanceDriverSize = sizeof(instanceDriver) - sizeof(WCHAR);
+
+            if (RegGetValueW(modelKey, instance, L"Driver", RRF_RT_REG_SZ, NULL, instanceDriver, &instanceDriverSize) != ERROR_SUCCESS
+                || _wcsicmp(instanceDriver, driver + 1) != 0)
+            {
+                continue;
+            }
+
+            WCHAR parameters[160];
+            swprintf(parameters, sizeof(parameters) / sizeof(WCHAR), L"%ls\\Device Parameters", instance);
+
+            DWORD size = 0;
+            if (RegGetValueW(modelKey, parameters, L"EDID", RRF_RT_REG_BINARY, NULL, NULL, &size) == ERROR_SUCCESS
+                && size >= 128)
+            {
+                data.resize(size);
+                found = RegGetValueW(modelKey, parameters, L"EDID", RRF_RT_REG_BINARY, NULL, data.data(), &size) == ERROR_SUCCESS;
+                data.resize(size);
+            }
+        }
+
+        RegCloseKey(modelKey);
+        return found;
+    }
 }
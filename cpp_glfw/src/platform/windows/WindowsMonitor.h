@@ -10,14 +10,20 @@ namespace cpp_glfw
         HMONITOR m_Handle = nullptr;
         WCHAR m_AdapterName[32] = {};
         WCHAR m_DisplayName[32] = {};
+        WCHAR m_DeviceID[128] = {}; //MONITOR\<model>\<driver key>, empty for adapters without displays
         char m_PublicAdapterName[32] = {};
         char m_PublicDisplayName[32] = {};
         bool m_ModesPruned = false; //the device has more display modes than its output devices support
         bool m_ModeChanged = false;
+        uint64_t m_Identity = 0; //hash of the adapter and display names and the display device id
+        uint32_t m_Generation = 0; //last monitor poll that enumerated this monitor
+        MonitorProperty m_PendingChanges = MonitorProperty::None;
 
     public: CPP_GLFW_INTERNAL_API
         static BOOL CALLBACK SetHandle(HMONITOR handle, HDC dc, RECT* rect, LPARAM data);
         static void GetContentScale(HMONITOR handle, float* xScale, float* yScale);
+        static uint64_t GetIdentity(const DISPLAY_DEVICEW* adapter, const DISPLAY_DEVICEW* display);
+        void RefreshHandle();
 
     public:
         WindowsMonitor(DISPLAY_DEVICEW* adapter, DISPLAY_DEVICEW* display);
@@ -28,12 +34,14 @@ namespace cpp_glfw
         void PlatformGetWorkarea(int32_t* x, int32_t* y, int32_t* width, int32_t* height) const override;
         void PlatformGetContentScale(float* xScale, float* yScale) const override;
 
-        void PlatformGetVideoModes(std::vector<VideoMode*>& videoModes) override;
+        void PlatformGetVideoModes(std::vector<VideoMode>& videoModes) override;
         void PlatformGetVideoMode(VideoMode* videoMode) override;
         void PlatformSetVideoMode(const VideoMode* videoMode) override;
         void PlatformRestoreVideoMode() override;
 
-        bool PlatformGetGammaRamp(GammaRamp* ramp) override;
-        void PlatformSetGammaRamp(const GammaRamp* ramp) override;
+        bool PlatformGetGammaRamp(MonitorGammaRamp* ramp) override;
+        void PlatformSetGammaRamp(const MonitorGammaRamp* ramp) override;
+
+        bool PlatformGetEdid(std::vector<uint8_t>& data) override;
     };
 }
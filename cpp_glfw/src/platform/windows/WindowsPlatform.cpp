@@ -8,9 +8,14 @@ namespace cpp_glfw
     HDEVNOTIFY WindowsPlatform::s_DeviceNotificationHandle = nullptr;
     DWORD WindowsPlatform::s_ForegroundLockTimeout = 0;
     int32_t WindowsPlatform::s_AcquiredMonitorCount = 0;
+    std::unordered_map<uint64_t, WindowsMonitor*> WindowsPlatform::s_MonitorRegistry = {};
+    std::unordered_map<HWND, uint32_t> WindowsPlatform::s_WindowHandles = {};
+    uint32_t WindowsPlatform::s_MonitorGeneration = 0;
+    bool WindowsPlatform::s_MonitorsDirty = false;
     bool WindowsPlatform::s_TimerHasPC = false;
     uint64_t WindowsPlatform::s_TimerFrequency = 0;
-    char* WindowsPlatform::s_ClipboardString = nullptr;
+    bool WindowsPlatform::s_ClipboardListener = false;
+    bool WindowsPlatform::s_ClipboardDirty = false;
     Key WindowsPlatform::s_Keycodes[] = {};
     int16_t WindowsPlatform::s_Scancodes[] = {};
     char WindowsPlatform::s_KeyNames[][5] = {};
@@ -19,6 +24,8 @@ namespace cpp_glfw
     Window* WindowsPlatform::s_DisabledCursorWindow = nullptr;
     RAWINPUT* WindowsPlatform::s_RawInput = nullptr;
     int32_t WindowsPlatform::s_RawInputSize = 0;
+    WCHAR* WindowsPlatform::s_WideScratch = nullptr;
+    size_t WindowsPlatform::s_WideScratchSize = 0;
     UINT WindowsPlatform::s_MouseTrailSize = 0;
     WindowsPlatform::WindowsLibs WindowsPlatform::s_Libs = {};
     std::vector<std::string> WindowsPlatform::s_EglLibNames = { "libEGL.dll", "EGL.dll" };
@@ -56,6 +63,19 @@ namespace cpp_glfw
 
         WindowsPlatform::InitTimer();
 
+        //sized for a mouse packet and a typical path, so the event loop starts out without allocating
+        if (!WindowsPlatform::ReserveRawInput(sizeof(RAWINPUT)))
+        {
+            return false;
+        }
+        WindowsPlatform::ReserveWideScratch(MAX_PATH);
+
+        //clipboard change notifications need Vista, without them the clipboard callback is never called
+        if (WindowsPlatform::s_Libs.user32.AddClipboardFormatListener)
+        {
+            WindowsPlatform::s_ClipboardListener = WindowsPlatform::s_Libs.user32.AddClipboardFormatListener(WindowsPlatform::s_HelperWindowHandle);
+        }
+
         WindowsPlatform::PollMonitors();
 
         return true;
@@ -63,11 +83,19 @@ namespace cpp_glfw
 
     void Platform::PlatformTerminate()
     {
+        WindowsClipboard::Terminate();
+
         if (WindowsPlatform::s_DeviceNotificationHandle)
         {
             UnregisterDeviceNotification(WindowsPlatform::s_DeviceNotificationHandle);
         }
 
+        if (WindowsPlatform::s_ClipboardListener)
+        {
+            WindowsPlatform::s_Libs.user32.RemoveClipboardFormatListener(WindowsPlatform::s_HelperWindowHandle);
+            WindowsPlatform::s_ClipboardListener = false;
+        }
+
         if (WindowsPlatform::s_HelperWindowHandle)
         {
             DestroyWindow(WindowsPlatform::s_HelperWindowHandle);
@@ -76,6 +104,17 @@ namespace cpp_glfw
         WindowsPlatform::UnregisterWindowClass();
         WindowsPlatform::RestoreForegroundLockTimeout();
 
+        //the monitors themselves are released by Platform::Terminate
+        WindowsPlatform::s_MonitorRegistry.clear();
+        WindowsPlatform::s_WindowHandles.clear();
+
+        Memory::Free(WindowsPlatform::s_RawInput);
+        WindowsPlatform::s_RawInput = nullptr;
+        WindowsPlatform::s_RawInputSize = 0;
+        Memory::Free(WindowsPlatform::s_WideScratch);
+        WindowsPlatform::s_WideScratch = nullptr;
+        WindowsPlatform::s_WideScratchSize = 0;
+
         WindowsWglContext::Terminate();
 
         WindowsPlatform::FreeLibraries();
@@ -100,6 +139,26 @@ namespace cpp_glfw
                 DispatchMessageW(&msg);
             }
         }
+
+        //a display change usually arrives as a burst of messages, re-enumerate once for all of them
+        if (WindowsPlatform::s_MonitorsDirty)
+        {
+            WindowsPlatform::PollMonitors();
+        }
+
+        if (WindowsPlatform::s_ClipboardDirty)
+        {
+            WindowsPlatform::s_ClipboardDirty = false;
+
+            if (s_Callbacks.clipboardChanged)
+            {
+                s_Callbacks.clipboardChanged();
+            }
+        }
+
+        WindowsClipboard::DispatchCompleted();
+
+        WindowsWindow::DeliverPendingDrops();
     }
 
     void Platform::PlatformWaitEvents()
@@ -149,52 +208,74 @@ namespace cpp_glfw
     }
 
 
-    const char* Platform::PlatformGetClipboardString()
+    uint32_t Platform::PlatformGetClipboardSequence()
+    {
+        return GetClipboardSequenceNumber();
+    }
+
+    /// <summary> Converts straight into the string, so its buffer is reused when the new text fits </summary>
+    bool Platform::PlatformGetClipboardString(TaggedString<MemoryTag::Clipboard>* string, bool* available)
     {
-        if (!OpenClipboard(WindowsPlatform::s_HelperWindowHandle))
+        string->clear();
+        *available = false;
+
+        //checking the format does not need the clipboard to be open
+        if (!IsClipboardFormatAvailable(CF_UNICODETEXT))
+        {
+            CPP_GLFW_ERROR("Clipboard does not contain a string!");
+            return true;
+        }
+
+        if (!WindowsClipboard::Open(WindowsPlatform::s_HelperWindowHandle))
         {
             CPP_GLFW_ERROR_WIN32("Failed to open clipboard!");
-            return nullptr;
+            return false;
         }
 
         HANDLE object = GetClipboardData(CF_UNICODETEXT);
         if (!object)
         {
             CPP_GLFW_ERROR_WIN32("Failed to convert clipboard to string!");
-            CloseClipboard();
-            return nullptr;
+            WindowsClipboard::Close();
+            return false;
         }
 
         WCHAR* buffer = (WCHAR*)GlobalLock(object);
         if (!buffer)
         {
             CPP_GLFW_ERROR_WIN32("Failed to lock global handle!");
-            CloseClipboard();
-            return nullptr;
+            WindowsClipboard::Close();
+            return false;
         }
 
-        free(WindowsPlatform::s_ClipboardString);
-        WindowsPlatform::s_ClipboardString = WindowsPlatform::WideStringToUTF8(buffer);
+        const int size = WideCharToMultiByte(CP_UTF8, 0, buffer, -1, NULL, 0, NULL, NULL);
+        if (size > 0)
+        {
+            string->resize(size);
+            WideCharToMultiByte(CP_UTF8, 0, buffer, -1, &(*string)[0], size, NULL, NULL);
+            string->resize(size - 1); //drop the terminator written by the conversion
+        }
 
         GlobalUnlock(object);
-        CloseClipboard();
+        WindowsClipboard::Close();
 
-        return WindowsPlatform::s_ClipboardString;
+        *available = true;
+        return true;
     }
 
-    void Platform::PlatformSetClipboardString(const char* string)
+    bool Platform::PlatformSetClipboardString(const char* string)
     {
         int characterCount = MultiByteToWideChar(CP_UTF8, 0, string, -1, NULL, 0);
         if (!characterCount)
         {
-            return;
+            return false;
         }
 
         HANDLE object = GlobalAlloc(GMEM_MOVEABLE, characterCount * sizeof(WCHAR));
         if (!object)
         {
             CPP_GLFW_ERROR_WIN32("Failed to allocate global handle for clipboard!");
-            return;
+            return false;
         }
 
         WCHAR* buffer = (WCHAR*)GlobalLock(object);
@@ -202,22 +283,42 @@ namespace cpp_glfw
         {
             CPP_GLFW_ERROR_WIN32("Failed to lock global handle!");
             GlobalFree(object);
-            return;
+            return false;
         }
 
         MultiByteToWideChar(CP_UTF8, 0, string, -1, buffer, characterCount);
         GlobalUnlock(object);
 
-        if (!OpenClipboard(WindowsPlatform::s_HelperWindowHandle))
+        if (!WindowsClipboard::Open(WindowsPlatform::s_HelperWindowHandle))
         {
             CPP_GLFW_ERROR_WIN32("Failed to open clipboard!");
             GlobalFree(object);
-            return;
+            return false;
         }
 
         EmptyClipboard();
-        SetClipboardData(CF_UNICODETEXT, object);
-        CloseClipboard();
+
+        if (!SetClipboardData(CF_UNICODETEXT, object))
+        {
+            CPP_GLFW_ERROR_WIN32("Failed to set clipboard data!");
+            GlobalFree(object);
+            WindowsClipboard::Close();
+            return false;
+        }
+
+        WindowsClipboard::Close();
+        return true;
+    }
+
+
+    bool Platform::PlatformRequestClipboardData(const char* mimeType, ClipboardDataCallback callback, void* user)
+    {
+        return WindowsClipboard::RequestData(mimeType, callback, user);
+    }
+
+    bool Platform::PlatformOfferClipboardData(const std::vector<std::string>& mimeTypes, ClipboardProviderCallback provider, void* user)
+    {
+        return WindowsClipboard::OfferData(mimeTypes, provider, user);
     }
 
 
@@ -300,7 +401,7 @@ namespace cpp_glfw
 
             if (type)
             {
-                *attribs = (EGLint*)calloc(3, sizeof(EGLint));
+                *attribs = (EGLint*)Memory::Calloc(3, sizeof(EGLint), MemoryTag::Context);
                 (*attribs)[0] = EGL_PLATFORM_ANGLE_TYPE_ANGLE;
                 (*attribs)[1] = type;
                 (*attribs)[2] = EGL_NONE;
@@ -339,6 +440,189 @@ namespace cpp_glfw
     }
 
 
+    bool Platform::PlatformMapFile(const std::string& path, MappedFile* file)
+    {
+        *file = {};
+
+        WCHAR* widePath = WindowsPlatform::UTF8ToWideString(path.c_str());
+        if (!widePath)
+        {
+            return false;
+        }
+
+        HANDLE fileHandle = CreateFileW(widePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        Memory::Free(widePath);
+
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            CPP_GLFW_ERROR_WIN32("Failed to open file!");
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(fileHandle, &size))
+        {
+            CPP_GLFW_ERROR_WIN32("Failed to query file size!");
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        if (size.QuadPart == 0)
+        {
+            //empty files cannot be mapped
+            CloseHandle(fileHandle);
+            return true;
+        }
+
+        //the mapping keeps the file open, so the file handle is not needed past this point
+        HANDLE mappingHandle = CreateFileMappingW(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+        CloseHandle(fileHandle);
+
+        if (!mappingHandle)
+        {
+            CPP_GLFW_ERROR_WIN32("Failed to create file mapping!");
+            return false;
+        }
+
+        const void* data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (!data)
+        {
+            CPP_GLFW_ERROR_WIN32("Failed to map view of file!");
+            CloseHandle(mappingHandle);
+            return false;
+        }
+
+        file->data = (const char*)data;
+        file->size = (size_t)size.QuadPart;
+        file->handle = mappingHandle;
+        return true;
+    }
+
+    void Platform::PlatformUnmapFile(MappedFile* file)
+    {
+        if (file->data)
+        {
+            UnmapViewOfFile(file->data);
+        }
+
+        if (file->handle)
+        {
+            CloseHandle((HANDLE)file->handle);
+        }
+
+        *file = {};
+    }
+
+    const char* Platform::PlatformGetMappingName()
+    {
+        return "Windows";
+    }
+
+    bool Platform::PlatformCreateOutputFile(const std::string& path, OutputFile* file)
+    {
+        *file = {};
+
+        WCHAR* widePath = WindowsPlatform::UTF8ToWideString(path.c_str());
+        if (!widePath)
+        {
+            return false;
+        }
+
+        HANDLE fileHandle = CreateFileW(widePath, GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        Memory::Free(widePath);
+
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            CPP_GLFW_ERROR_WIN32("Failed to create file!");
+            return false;
+        }
+
+        OVERLAPPED* overlapped = (OVERLAPPED*)Memory::Calloc(1, sizeof(OVERLAPPED), MemoryTag::Capture);
+        overlapped->hEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+        if (!overlapped->hEvent)
+        {
+            CPP_GLFW_ERROR_WIN32("Failed to create file write event!");
+            Memory::Free(overlapped);
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        file->handle = fileHandle;
+        file->overlapped = overlapped;
+        return true;
+    }
+
+    /// <summary> Queues the write and returns, the data must stay untouched until the next write or close </summary>
+    bool Platform::PlatformWriteOutputFile(OutputFile* file, const void* data, size_t size)
+    {
+        OVERLAPPED* overlapped = (OVERLAPPED*)file->overlapped;
+
+        if (file->pending)
+        {
+            DWORD written;
+            file->pending = false;
+            if (!GetOverlappedResult((HANDLE)file->handle, overlapped, &written, TRUE))
+            {
+                CPP_GLFW_ERROR_WIN32("Failed to write file!");
+                return false;
+            }
+        }
+
+        if (size > MAXDWORD)
+        {
+            CPP_GLFW_ERROR("Cannot write more than 4 GB at once!");
+            return false;
+        }
+
+        overlapped->Offset = (DWORD)file->offset;
+        overlapped->OffsetHigh = (DWORD)(file->offset >> 32);
+        ResetEvent(overlapped->hEvent);
+
+        if (!WriteFile((HANDLE)file->handle, data, (DWORD)size, NULL, overlapped)
+            && GetLastError() != ERROR_IO_PENDING)
+        {
+            CPP_GLFW_ERROR_WIN32("Failed to write file!");
+            return false;
+        }
+
+        //a write that completed synchronously still signals the event, so waiting on it later is fine
+        file->pending = true;
+        file->offset += size;
+        return true;
+    }
+
+    bool Platform::PlatformCloseOutputFile(OutputFile* file)
+    {
+        bool result = true;
+        OVERLAPPED* overlapped = (OVERLAPPED*)file->overlapped;
+
+        if (file->pending)
+        {
+            DWORD written;
+            if (!GetOverlappedResult((HANDLE)file->handle, overlapped, &written, TRUE))
+            {
+                CPP_GLFW_ERROR_WIN32("Failed to write file!");
+                result = false;
+            }
+        }
+
+        if (overlapped)
+        {
+            CloseHandle(overlapped->hEvent);
+            Memory::Free(overlapped);
+        }
+
+        if (file->handle)
+        {
+            CloseHandle((HANDLE)file->handle);
+        }
+
+        *file = {};
+        return result;
+    }
+
+
     bool WindowsPlatform::LoadLibraries()
     {
         //XInput
@@ -380,6 +664,8 @@ namespace cpp_glfw
         }
 
         s_Libs.winmm.GetTime = (PFN_timeGetTime)GetProcAddress(s_Libs.winmm.instance, "timeGetTime");
+        s_Libs.winmm.BeginPeriod = (PFN_timeBeginPeriod)GetProcAddress(s_Libs.winmm.instance, "timeBeginPeriod");
+        s_Libs.winmm.EndPeriod = (PFN_timeEndPeriod)GetProcAddress(s_Libs.winmm.instance, "timeEndPeriod");
 
         s_Libs.user32.instance = LoadLibraryA("user32.dll");
         if (!s_Libs.user32.instance)
@@ -394,6 +680,9 @@ namespace cpp_glfw
         s_Libs.user32.SetProcessDpiAwarenessContext = (PFN_SetProcessDpiAwarenessContext)GetProcAddress(s_Libs.user32.instance, "SetProcessDpiAwarenessContext");
         s_Libs.user32.GetDpiForWindow = (PFN_GetDpiForWindow)GetProcAddress(s_Libs.user32.instance, "GetDpiForWindow");
         s_Libs.user32.AdjustWindowRectExForDpi = (PFN_AdjustWindowRectExForDpi)GetProcAddress(s_Libs.user32.instance, "AdjustWindowRectExForDpi");
+        s_Libs.user32.GetSystemMetricsForDpi = (PFN_GetSystemMetricsForDpi)GetProcAddress(s_Libs.user32.instance, "GetSystemMetricsForDpi");
+        s_Libs.user32.AddClipboardFormatListener = (PFN_AddClipboardFormatListener)GetProcAddress(s_Libs.user32.instance, "AddClipboardFormatListener");
+        s_Libs.user32.RemoveClipboardFormatListener = (PFN_RemoveClipboardFormatListener)GetProcAddress(s_Libs.user32.instance, "RemoveClipboardFormatListener");
 
         s_Libs.dwmapi.instance = LoadLibraryA("dwmapi.dll");
         if (s_Libs.dwmapi.instance)
@@ -678,17 +967,24 @@ namespace cpp_glfw
     }
 
 
+    /// <summary>
+    /// Diffs the active displays against the monitor registry in one enumeration.
+    /// Known monitors are found by identity in constant time, so the diff is linear in the display count,
+    /// and existing monitors only report the properties that changed.
+    /// </summary>
     void WindowsPlatform::PollMonitors()
     {
-        //copy the array of pointers to the monitors
-        std::vector<Monitor*> disconnected = s_Monitors;
+        s_MonitorsDirty = false;
+        s_MonitorGeneration++;
+
+        Monitor* previousPrimary = s_Monitors.size() ? s_Monitors[0] : nullptr;
+        WindowsMonitor* primary = nullptr;
+        std::vector<WindowsMonitor*> added;
 
         //loop display adapters
         uint32_t adapterIndex;
         for (adapterIndex = 0; ; adapterIndex++)
         {
-            bool insertFirst = false;
-
             DISPLAY_DEVICEW adapter = {};
             adapter.cb = sizeof(adapter);
 
@@ -702,11 +998,6 @@ namespace cpp_glfw
                 continue;
             }
 
-            if (adapter.StateFlags & DISPLAY_DEVICE_PRIMARY_DEVICE)
-            {
-                insertFirst = true;
-            }
-
             //loop adapter monitors
             uint32_t displayIndex;
             for (displayIndex = 0; ; displayIndex++)
@@ -724,126 +1015,167 @@ namespace cpp_glfw
                     continue;
                 }
 
-                //if this monitor is in the disconnected array, set the position as null and just refresh the handle
-                uint32_t d;
-                for (d = 0; d < disconnected.size(); d++)
-                {
-                    if (disconnected[d]
-                        && wcscmp(((WindowsMonitor*)disconnected[d])->m_DisplayName, display.DeviceName) == 0)
-                    {
-                        disconnected[d] = nullptr;
-
-                        EnumDisplayMonitors(nullptr, nullptr, WindowsMonitor::SetHandle, (LPARAM)s_Monitors[d]);
-                        break;
-                    }
-                }
-
-                if (d < disconnected.size())
-                {
-                    continue;
-                }
-
-                //if the monitor didn't already exist, create a new one
-                WindowsMonitor* monitor = new WindowsMonitor(&adapter, &display);
+                WindowsMonitor* monitor = RegisterMonitor(&adapter, &display, added);
                 if (!monitor)
                 {
-                    return;
-                }
-
-                //insert it in the m_Monitors array
-                if (insertFirst)
-                {
-                    s_Monitors.insert(s_Monitors.begin(), monitor);
-                }
-                else
-                {
-                    s_Monitors.push_back(monitor);
+                    continue;
                 }
-                insertFirst = false;
 
-                //call the MonitorConnected callback
-                if (s_Callbacks.monitorConnected)
+                //the first display of the primary adapter is the primary monitor
+                if (!primary
+                    && (adapter.StateFlags & DISPLAY_DEVICE_PRIMARY_DEVICE))
                 {
-                    s_Callbacks.monitorConnected((Monitor*)monitor);
+                    primary = monitor;
                 }
             }
 
             //if an active adapter does not have any display devices add it as a monitor
             if (displayIndex == 0)
             {
-                //if this adapter (as monitor) is in the disconnected array, set the position as null and just refresh the handle
-                uint32_t d;
-                for (d = 0; d < disconnected.size(); d++)
-                {
-                    if (disconnected[d]
-                        && wcscmp(((WindowsMonitor*)disconnected[d])->m_DisplayName, adapter.DeviceName) == 0)
-                    {
-                        disconnected[d] = nullptr;
-                        break;
-                    }
-                }
+                WindowsMonitor* monitor = RegisterMonitor(&adapter, nullptr, added);
 
-                if (d < disconnected.size())
+                if (monitor
+                    && !primary
+                    && (adapter.StateFlags & DISPLAY_DEVICE_PRIMARY_DEVICE))
                 {
-                    continue;
+                    primary = monitor;
                 }
+            }
+        }
 
-                //if the monitor didn't already exist, create a new one
-                WindowsMonitor* monitor = new WindowsMonitor(&adapter, nullptr);
-                if (!monitor)
-                {
-                    return;
-                }
+        //split the monitors that were not enumerated off the end of the array, keeping the order of the rest
+        const auto removedBegin = std::stable_partition(s_Monitors.begin(), s_Monitors.end(), [](Monitor* monitor)
+        {
+            return ((WindowsMonitor*)monitor)->m_Generation == s_MonitorGeneration;
+        });
 
-                //insert it in the m_Monitors array
-                s_Monitors.push_back(monitor);
+        std::vector<Monitor*> removed(removedBegin, s_Monitors.end());
+        s_Monitors.erase(removedBegin, s_Monitors.end());
 
-                //call the MonitorConnected callback
-                if (s_Callbacks.monitorConnected)
+        //release the disconnected monitors
+        for (Monitor* monitor : removed)
+        {
+            for (Window* window : s_Windows)
+            {
+                if (window->GetMonitor() == monitor)
                 {
-                    s_Callbacks.monitorConnected((Monitor*)monitor);
+                    int32_t width, height;
+                    window->GetSize(&width, &height);
+                    window->SetMonitor(nullptr, 0, 0, width, height, 0);
+
+                    int32_t xOffset, yOffset;
+                    window->GetFrameSize(&xOffset, &yOffset, nullptr, nullptr);
+                    window->SetPosition(xOffset, yOffset);
                 }
             }
+
+            s_MonitorRegistry.erase(((WindowsMonitor*)monitor)->m_Identity);
+
+            //call the MonitorDisconnected callback
+            if (s_Callbacks.monitorDisconnected)
+            {
+                s_Callbacks.monitorDisconnected(monitor);
+            }
+
+            delete monitor;
         }
 
-        //release remaining monitors in the disconnected array since they were not found
-        for (uint32_t d = 0; d < disconnected.size(); d++)
+        //keep the primary monitor first
+        if (primary
+            && s_Monitors[0] != primary)
         {
-            if (disconnected[d])
-            {
-                Monitor* monitor = s_Monitors[d];
+            const auto position = std::find(s_Monitors.begin(), s_Monitors.end(), (Monitor*)primary);
+            std::rotate(s_Monitors.begin(), position, position + 1);
+        }
 
-                for (Window* window : s_Windows)
-                {
-                    if (window->GetMonitor() == monitor)
-                    {
-                        int32_t width, height;
-                        window->GetSize(&width, &height);
-                        window->SetMonitor(nullptr, 0, 0, width, height, 0);
-
-                        int32_t xOffset, yOffset;
-                        window->GetFrameSize(&xOffset, &yOffset, nullptr, nullptr);
-                        window->SetPosition(xOffset, yOffset);
-                    }
-                }
+        if (previousPrimary
+            && s_Monitors.size()
+            && previousPrimary != s_Monitors[0]
+            && std::find(removed.begin(), removed.end(), previousPrimary) == removed.end())
+        {
+            ((WindowsMonitor*)previousPrimary)->m_PendingChanges = ((WindowsMonitor*)previousPrimary)->m_PendingChanges | MonitorProperty::Primary;
+            ((WindowsMonitor*)s_Monitors[0])->m_PendingChanges = ((WindowsMonitor*)s_Monitors[0])->m_PendingChanges | MonitorProperty::Primary;
+        }
 
-                //remove this monitor from the m_Monitors array
-                s_Monitors.erase(s_Monitors.begin() + d);
+        //call the MonitorConnected callback
+        for (WindowsMonitor* monitor : added)
+        {
+            monitor->m_PendingChanges = MonitorProperty::None;
 
-                //also remove this monitor from the disconnected array to keep indices in sync with m_Monitors array
-                disconnected.erase(disconnected.begin() + d);
+            if (s_Callbacks.monitorConnected)
+            {
+                s_Callbacks.monitorConnected((Monitor*)monitor);
+            }
+        }
 
-                //call the MonitorDisconnected callback
-                if (s_Callbacks.monitorDisconnected)
-                {
-                    s_Callbacks.monitorDisconnected((Monitor*)monitor);
-                }
+        //call the MonitorChanged callback with only the properties that changed
+        for (Monitor* monitor : s_Monitors)
+        {
+            WindowsMonitor* windowsMonitor = (WindowsMonitor*)monitor;
+            const MonitorProperty changes = windowsMonitor->m_PendingChanges;
+            windowsMonitor->m_PendingChanges = MonitorProperty::None;
 
-                delete monitor;
+            if (changes != MonitorProperty::None
+                && s_Callbacks.monitorChanged)
+            {
+                s_Callbacks.monitorChanged(monitor, changes);
             }
         }
     }
 
+    /// <summary> Drops cached monitor values so the next getter call reads them from the system again </summary>
+    void WindowsPlatform::InvalidateMonitors(MonitorProperty properties)
+    {
+        for (Monitor* monitor : s_Monitors)
+        {
+            monitor->InvalidateCache(properties);
+        }
+    }
+
+    /// <summary> Finds the monitor of an enumerated display by identity, creating it if it is new, returns nullptr if it could not be allocated </summary>
+    WindowsMonitor* WindowsPlatform::RegisterMonitor(DISPLAY_DEVICEW* adapter, DISPLAY_DEVICEW* display, std::vector<WindowsMonitor*>& added)
+    {
+        const uint64_t identity = WindowsMonitor::GetIdentity(adapter, display);
+
+        auto it = s_MonitorRegistry.find(identity);
+        if (it != s_MonitorRegistry.end())
+        {
+            WindowsMonitor* monitor = it->second;
+            monitor->m_Generation = s_MonitorGeneration;
+            monitor->RefreshHandle();
+            monitor->m_PendingChanges = monitor->RefreshProperties();
+            return monitor;
+        }
+
+        WindowsMonitor* monitor = new WindowsMonitor(adapter, display);
+        if (!monitor)
+        {
+            return nullptr;
+        }
+
+        monitor->m_Identity = identity;
+        monitor->m_Generation = s_MonitorGeneration;
+        monitor->RefreshProperties();
+
+        s_MonitorRegistry[identity] = monitor;
+        s_Monitors.push_back(monitor);
+        added.push_back(monitor);
+        return monitor;
+    }
+
+
+    /// <summary> Returns nullptr for the helper window and for windows that are being destroyed </summary>
+    WindowsWindow* WindowsPlatform::GetWindowFromHandle(HWND handle)
+    {
+        auto it = s_WindowHandles.find(handle);
+        if (it == s_WindowHandles.end())
+        {
+            return nullptr;
+        }
+
+        return (WindowsWindow*)s_WindowSlots.Get(it->second);
+    }
+
 
     void WindowsPlatform::InitTimer()
     {
@@ -1007,12 +1339,12 @@ namespace cpp_glfw
             return nullptr;
         }
 
-        target = (char*)calloc(size, 1);
+        target = (char*)Memory::Calloc(size, 1, MemoryTag::General);
 
         if (!WideCharToMultiByte(CP_UTF8, 0, source, -1, target, size, NULL, NULL))
         {
             CPP_GLFW_ERROR_WIN32("Failed to convert wide string to UTF8!");
-            free(target);
+            Memory::Free(target);
             return nullptr;
         }
 
@@ -1025,7 +1357,7 @@ namespace cpp_glfw
         if (name)
         {
             target = std::string(name);
-            free(name);
+            Memory::Free(name);
             return true;
         }
         return false;
@@ -1053,15 +1385,81 @@ namespace cpp_glfw
             return nullptr;
         }
 
-        target = (WCHAR*)calloc(count, sizeof(WCHAR));
+        target = (WCHAR*)Memory::Calloc(count, sizeof(WCHAR), MemoryTag::General);
 
         if (!MultiByteToWideChar(CP_UTF8, 0, source, -1, target, count))
         {
             CPP_GLFW_ERROR_WIN32("Failed to convert UTF8 to wide string!");
-            free(target);
+            Memory::Free(target);
             return nullptr;
         }
 
         return target;
     }
+
+    /// <summary> Converts into the shared scratch buffer, the result is only valid until the next scratch use on the event thread </summary>
+    const WCHAR* WindowsPlatform::UTF8ToWideScratch(const char* source)
+    {
+        const int count = MultiByteToWideChar(CP_UTF8, 0, source, -1, NULL, 0);
+        if (!count)
+        {
+            CPP_GLFW_ERROR_WIN32("Failed to convert UTF8 to wide string!");
+            return nullptr;
+        }
+
+        WCHAR* target = ReserveWideScratch(count);
+        if (!target)
+        {
+            return nullptr;
+        }
+
+        if (!MultiByteToWideChar(CP_UTF8, 0, source, -1, target, count))
+        {
+            CPP_GLFW_ERROR_WIN32("Failed to convert UTF8 to wide string!");
+            return nullptr;
+        }
+
+        return target;
+    }
+
+    /// <summary> Only grows, so repeated conversions of similar lengths stop allocating </summary>
+    WCHAR* WindowsPlatform::ReserveWideScratch(size_t count)
+    {
+        if (count <= s_WideScratchSize)
+        {
+            return s_WideScratch;
+        }
+
+        const size_t size = std::max(count, s_WideScratchSize * 2);
+
+        //the old contents are not needed, but reallocating lets the allocator grow the block in place
+        WCHAR* scratch = (WCHAR*)Memory::Reallocate(s_WideScratch, size * sizeof(WCHAR), MemoryTag::General);
+        if (!scratch)
+        {
+            return nullptr;
+        }
+
+        s_WideScratch = scratch;
+        s_WideScratchSize = size;
+        return s_WideScratch;
+    }
+
+    bool WindowsPlatform::ReserveRawInput(UINT size)
+    {
+        if (size <= (UINT)s_RawInputSize)
+        {
+            return true;
+        }
+
+        RAWINPUT* rawInput = (RAWINPUT*)Memory::Calloc(size, 1, MemoryTag::Input);
+        if (!rawInput)
+        {
+            return false;
+        }
+
+        Memory::Free(s_RawInput);
+        s_RawInput = rawInput;
+        s_RawInputSize = (int32_t)size;
+        return true;
+    }
 }
@@ -4,9 +4,12 @@
 #include "platform/windows/WindowsBase.h"
 #include "platform/windows/WindowsThreadLocalStorage.h"
 #include "platform/windows/WindowsWglContext.h"
+#include "platform/windows/WindowsSoftwareContext.h"
 #include "platform/windows/WindowsCursor.h"
 #include "platform/windows/WindowsMonitor.h"
 #include "platform/windows/WindowsWindow.h"
+#include "platform/windows/WindowsJoystick.h"
+#include "platform/windows/WindowsClipboard.h"
 
 namespace cpp_glfw
 {
@@ -17,17 +20,24 @@ namespace cpp_glfw
         static HDEVNOTIFY s_DeviceNotificationHandle;
         static DWORD s_ForegroundLockTimeout;
         static int32_t s_AcquiredMonitorCount;
+        static std::unordered_map<uint64_t, WindowsMonitor*> s_MonitorRegistry; //keyed by WindowsMonitor::m_Identity
+        static std::unordered_map<HWND, uint32_t> s_WindowHandles; //window ids by native handle, for the window procedure
+        static uint32_t s_MonitorGeneration;
+        static bool s_MonitorsDirty; //set by display change messages, handled once at the end of PollEvents
         static bool s_TimerHasPC;
         static uint64_t s_TimerFrequency;
-        static char* s_ClipboardString;
+        static bool s_ClipboardListener; //the helper window receives WM_CLIPBOARDUPDATE
+        static bool s_ClipboardDirty; //set by WM_CLIPBOARDUPDATE, reported once at the end of PollEvents
         static Key s_Keycodes[512];
         static int16_t s_Scancodes[(int32_t)Key::Count];
         static char s_KeyNames[(int32_t)Key::Count][5];
         static double s_RestoreCursorPositionX; //where to place the cursor when re-enabled
         static double s_RestoreCursorPositionY;
         static Window* s_DisabledCursorWindow; //the window whose disabled cursor mode is active
-        static RAWINPUT* s_RawInput;
+        static RAWINPUT* s_RawInput; //grown on demand and kept, so WM_INPUT does not allocate once warmed up
         static int32_t s_RawInputSize;
+        static WCHAR* s_WideScratch; //reused by conversions on the event thread
+        static size_t s_WideScratchSize; //in characters
         static UINT s_MouseTrailSize;
         static std::vector<std::string> s_EglLibNames;
         static std::vector<std::string> s_GLES1LibNames;
@@ -54,6 +64,8 @@ namespace cpp_glfw
             {
                 HINSTANCE instance;
                 PFN_timeGetTime GetTime;
+                PFN_timeBeginPeriod BeginPeriod;
+                PFN_timeEndPeriod EndPeriod;
             } winmm;
 
             struct User32Lib
@@ -65,6 +77,9 @@ namespace cpp_glfw
                 PFN_SetProcessDpiAwarenessContext SetProcessDpiAwarenessContext;
                 PFN_GetDpiForWindow GetDpiForWindow;
                 PFN_AdjustWindowRectExForDpi AdjustWindowRectExForDpi;
+                PFN_GetSystemMetricsForDpi GetSystemMetricsForDpi;
+                PFN_AddClipboardFormatListener AddClipboardFormatListener;
+                PFN_RemoveClipboardFormatListener RemoveClipboardFormatListener;
             } user32;
 
             struct DwmapiLib
@@ -105,6 +120,10 @@ namespace cpp_glfw
         static void AdjustRect(RECT* rect, DWORD style, DWORD styleEx, UINT dpi);
 
         static void PollMonitors();
+        static void InvalidateMonitors(MonitorProperty properties);
+        static WindowsMonitor* RegisterMonitor(DISPLAY_DEVICEW* adapter, DISPLAY_DEVICEW* display, std::vector<WindowsMonitor*>& added);
+
+        static WindowsWindow* GetWindowFromHandle(HWND handle);
 
         static void InitTimer();
 
@@ -126,6 +145,9 @@ namespace cpp_glfw
         static bool WideStringToUTF8(const WCHAR source[], char target[]);
         static bool WideStringToUTF8(const WCHAR source[], char target[], int32_t processCharCount);
         static WCHAR* UTF8ToWideString(const char* source);
+        static const WCHAR* UTF8ToWideScratch(const char* source);
+        static WCHAR* ReserveWideScratch(size_t count);
+        static bool ReserveRawInput(UINT size);
     };
 }
 
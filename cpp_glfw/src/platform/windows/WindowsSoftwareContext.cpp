@@ -0,0 +1,260 @@
+#include "platform/windows/WindowsPlatform.h"
+
+namespace cpp_glfw
+{
+    ////////////////////////////////////// INTERNAL API ///////////////////////////////////////
+
+    bool WindowsSoftwareContext::CreateContext(WindowsWindow* window, const ContextConfig* contextConfig)
+    {
+        HDC dc = GetDC(window->m_Handle);
+        if (!dc)
+        {
+            CPP_GLFW_ERROR_WIN32("Failed to retrieve DC for software framebuffer!");
+            return false;
+        }
+
+        WindowsSoftwareContext* context = new WindowsSoftwareContext();
+        if (!context)
+        {
+            ReleaseDC(window->m_Handle, dc);
+            return false;
+        }
+
+        context->m_API = ContextAPI::Software;
+        context->m_Type = contextConfig->type;
+        context->m_DC = dc;
+
+        window->m_Context = context;
+
+        int32_t width, height;
+        window->PlatformGetFramebufferSize(&width, &height);
+
+        return context->Resize(std::max(width, 1), std::max(height, 1));
+    }
+
+    /// <summary> Repaints the window from the last presented buffer, called on WM_PAINT </summary>
+    void WindowsSoftwareContext::PresentFront(WindowsWindow* window)
+    {
+        WindowsSoftwareContext* context = (WindowsSoftwareContext*)window->m_Context;
+        const Buffer& front = context->m_Buffers[context->m_Back ^ 1];
+
+        if (front.age == 0)
+        {
+            return;
+        }
+
+        const RECT rect = { 0, 0, context->m_Width, context->m_Height };
+        context->Present(front, rect);
+        GdiFlush();
+    }
+
+
+
+    ///////////////////////////////////// PLATFORM API ////////////////////////////////////////
+
+    bool Context::PlatformGetSoftwareFramebuffer(Window* window, SoftwareFramebuffer* framebuffer)
+    {
+        WindowsSoftwareContext* context = (WindowsSoftwareContext*)window->GetContext();
+
+        int32_t width, height;
+        window->GetFramebufferSize(&width, &height);
+
+        //a minimized window has an empty client area, keep the buffers for when it is restored
+        if (width > 0
+            && height > 0
+            && (width != context->m_Width || height != context->m_Height))
+        {
+            if (!context->Resize(width, height))
+            {
+                return false;
+            }
+        }
+
+        const WindowsSoftwareContext::Buffer& back = context->m_Buffers[context->m_Back];
+        framebuffer->pixels = back.pixels;
+        framebuffer->width = context->m_Width;
+        framebuffer->height = context->m_Height;
+        framebuffer->stride = context->m_Stride;
+        framebuffer->age = back.age;
+        return true;
+    }
+
+    void Context::PlatformAddDamageRect(Window* window, int32_t x, int32_t y, int32_t width, int32_t height)
+    {
+        WindowsSoftwareContext* context = (WindowsSoftwareContext*)window->GetContext();
+
+        RECT rect;
+        rect.left = std::max(x, 0);
+        rect.top = std::max(y, 0);
+        rect.right = std::min(x + width, context->m_Width);
+        rect.bottom = std::min(y + height, context->m_Height);
+
+        if (rect.left >= rect.right
+            || rect.top >= rect.bottom)
+        {
+            return;
+        }
+
+        if (context->m_Damage.size() < WindowsSoftwareContext::MaxDamageRects)
+        {
+            context->m_Damage.push_back(rect);
+            return;
+        }
+
+        //too many small blits cost more than one larger one, merge everything into the bounding rect
+        RECT bounds = rect;
+        for (const RECT& damage : context->m_Damage)
+        {
+            UnionRect(&bounds, &bounds, &damage);
+        }
+
+        context->m_Damage.clear();
+        context->m_Damage.push_back(bounds);
+    }
+
+    void Context::PlatformSwapSoftwareBuffers(Window* window)
+    {
+        WindowsSoftwareContext* context = (WindowsSoftwareContext*)window->GetContext();
+        WindowsSoftwareContext::Buffer& back = context->m_Buffers[context->m_Back];
+
+        if (context->m_Damage.empty())
+        {
+            const RECT rect = { 0, 0, context->m_Width, context->m_Height };
+            context->Present(back, rect);
+        }
+        else
+        {
+            for (const RECT& rect : context->m_Damage)
+            {
+                context->Present(back, rect);
+            }
+            context->m_Damage.clear();
+        }
+
+        //GDI batches calls, flush so the blits are done reading before the application writes to this buffer again
+        GdiFlush();
+
+        for (WindowsSoftwareContext::Buffer& buffer : context->m_Buffers)
+        {
+            if (buffer.age > 0)
+            {
+                buffer.age++;
+            }
+        }
+
+        back.age = 1;
+        context->m_Back ^= 1;
+    }
+
+    void Context::PlatformDestroySoftwareContext(Window* window)
+    {
+        WindowsSoftwareContext* context = (WindowsSoftwareContext*)window->GetContext();
+
+        for (WindowsSoftwareContext::Buffer& buffer : context->m_Buffers)
+        {
+            context->DestroyBuffer(&buffer);
+        }
+    }
+
+
+
+    ///////////////////////////////////////// UTILS ///////////////////////////////////////////
+
+    bool WindowsSoftwareContext::Resize(int32_t width, int32_t height)
+    {
+        for (Buffer& buffer : m_Buffers)
+        {
+            DestroyBuffer(&buffer);
+        }
+
+        m_Width = width;
+        m_Height = height;
+        m_Stride = (width * 4 + 63) & ~63;
+        m_Back = 0;
+        m_Damage.clear();
+
+        //the padding at the end of each row is part of the bitmap width, it is never presented
+        m_Info = {};
+        m_Info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+        m_Info.bmiHeader.biWidth = m_Stride / 4;
+        m_Info.bmiHeader.biHeight = -height; //top down
+        m_Info.bmiHeader.biPlanes = 1;
+        m_Info.bmiHeader.biBitCount = 32;
+        m_Info.bmiHeader.biCompression = BI_RGB;
+
+        for (Buffer& buffer : m_Buffers)
+        {
+            if (!CreateBuffer(&buffer))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool WindowsSoftwareContext::CreateBuffer(Buffer* buffer)
+    {
+        buffer->age = 0;
+
+        void* pixels = nullptr;
+        buffer->bitmap = CreateDIBSection(m_DC, &m_Info, DIB_RGB_COLORS, &pixels, NULL, 0);
+        buffer->dc = buffer->bitmap ? CreateCompatibleDC(m_DC) : NULL;
+
+        if (buffer->dc)
+        {
+            buffer->previousBitmap = SelectObject(buffer->dc, buffer->bitmap);
+            buffer->pixels = (uint8_t*)pixels;
+            return true;
+        }
+
+        CPP_GLFW_WARN("Failed to create DIB section, falling back to SetDIBitsToDevice");
+
+        if (buffer->bitmap)
+        {
+            DeleteObject(buffer->bitmap);
+            buffer->bitmap = NULL;
+        }
+
+        buffer->fallback.assign((size_t)m_Stride * m_Height, 0);
+        buffer->pixels = buffer->fallback.data();
+        return buffer->pixels != nullptr;
+    }
+
+    void WindowsSoftwareContext::DestroyBuffer(Buffer* buffer)
+    {
+        if (buffer->dc)
+        {
+            SelectObject(buffer->dc, buffer->previousBitmap);
+            DeleteDC(buffer->dc);
+            buffer->dc = NULL;
+        }
+
+        if (buffer->bitmap)
+        {
+            DeleteObject(buffer->bitmap);
+            buffer->bitmap = NULL;
+        }
+
+        buffer->fallback.clear();
+        buffer->pixels = nullptr;
+        buffer->age = 0;
+    }
+
+    void WindowsSoftwareContext::Present(const Buffer& buffer, const RECT& rect)
+    {
+        const int32_t width = rect.right - rect.left;
+        const int32_t height = rect.bottom - rect.top;
+
+        if (buffer.dc)
+        {
+            BitBlt(m_DC, rect.left, rect.top, width, height, buffer.dc, rect.left, rect.top, SRCCOPY);
+        }
+        else
+        {
+            //the source origin of a top down DIB is its upper left corner
+            SetDIBitsToDevice(m_DC, rect.left, rect.top, width, height, rect.left, rect.top,
+                0, m_Height, buffer.pixels, &m_Info, DIB_RGB_COLORS);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "platform/windows/WindowsBase.h"
+
+namespace cpp_glfw
+{
+    class WindowsWindow;
+
+    /// <summary>
+    /// Software framebuffer backed by two GDI DIB sections.
+    /// The application writes straight into the section memory and SwapBuffers blits only the damaged rects,
+    /// so there is no copy between the application and GDI. The front buffer is kept to repaint the window on WM_PAINT.
+    /// If a DIB section cannot be created the buffer falls back to plain memory presented with SetDIBitsToDevice.
+    /// </summary>
+    class WindowsSoftwareContext : public Context
+    {
+    public:
+        static constexpr int32_t MaxDamageRects = 16; //above this the damage is merged into its bounding rect
+
+        struct Buffer
+        {
+            HDC dc;
+            HBITMAP bitmap;
+            HGDIOBJ previousBitmap;
+            uint8_t* pixels;
+            std::vector<uint8_t> fallback; //owns the pixels when there is no DIB section
+            int32_t age;
+        };
+
+    public:
+        HDC m_DC;
+        BITMAPINFO m_Info;
+        Buffer m_Buffers[2];
+        int32_t m_Back;
+        int32_t m_Width;
+        int32_t m_Height;
+        int32_t m_Stride;
+        std::vector<RECT> m_Damage;
+
+    public: CPP_GLFW_INTERNAL_API
+        static bool CreateContext(WindowsWindow* window, const ContextConfig* contextConfig);
+        static void PresentFront(WindowsWindow* window);
+
+    protected: CPP_GLFW_UTILS
+        bool Resize(int32_t width, int32_t height);
+        bool CreateBuffer(Buffer* buffer);
+        void DestroyBuffer(Buffer* buffer);
+        void Present(const Buffer& buffer, const RECT& rect);
+    };
+}
@@ -12,6 +12,12 @@ namespace cpp_glfw
         }
 
         WindowsThreadLocalStorage* tls = new WindowsThreadLocalStorage();
+        if (!tls)
+        {
+            TlsFree(index);
+            return nullptr;
+        }
+
         tls->m_Index = index;
         tls->m_Allocated = true;
 
@@ -336,6 +336,12 @@ namespace cpp_glfw
             }
 
             WindowsWglContext* wglContext = new WindowsWglContext();
+            if (!wglContext)
+            {
+                s_WGL.deleteContext(contextHandle);
+                return false;
+            }
+
             wglContext->m_DC = dc;
             wglContext->m_Handle = contextHandle;
 
@@ -361,6 +367,12 @@ namespace cpp_glfw
             }
 
             WindowsWglContext* wglContext = new WindowsWglContext();
+            if (!wglContext)
+            {
+                s_WGL.deleteContext(contextHandle);
+                return false;
+            }
+
             wglContext->m_DC = dc;
             wglContext->m_Handle = contextHandle;
 
@@ -29,7 +29,7 @@ namespace cpp_glfw
                 pThis = (WindowsWindow*)pCreate->lpCreateParams;
                 pThis->m_Handle = hwnd;
 
-                SetPropW(hwnd, CPP_GLFW_WINDOW_PROP, pThis);
+                WindowsPlatform::s_WindowHandles[hwnd] = pThis->m_Id;
 
                 if (WindowsPlatform::IsWindows10AnniversaryUpdateOrGreater())
                 {
@@ -46,7 +46,7 @@ namespace cpp_glfw
         }
         else
         {
-            pThis = (WindowsWindow*)GetPropW(hwnd, CPP_GLFW_WINDOW_PROP);
+            pThis = WindowsPlatform::GetWindowFromHandle(hwnd);
         }
 
         if (pThis)
@@ -60,33 +60,70 @@ namespace cpp_glfw
             {
                 case WM_DISPLAYCHANGE:
                 {
-                    WindowsPlatform::PollMonitors();
+                    //coalesced, the monitors are polled once at the end of PollEvents
+                    WindowsPlatform::InvalidateMonitors(MonitorProperty::Position | MonitorProperty::Workarea | MonitorProperty::ContentScale);
+                    WindowsPlatform::s_MonitorsDirty = true;
                     break;
                 }
 
-                case WM_DEVICECHANGE:
+                case WM_SETTINGCHANGE:
+                {
+                    if (wParam == SPI_SETWORKAREA)
+                    {
+                        WindowsPlatform::InvalidateMonitors(MonitorProperty::Workarea);
+                        WindowsPlatform::s_MonitorsDirty = true;
+                    }
+                    break;
+                }
+
+                case WM_CLIPBOARDUPDATE:
                 {
-                    //if (!joysticksInitialized)
-                    //{
-                    //    break;
-                    //}
+                    WindowsPlatform::s_ClipboardDirty = true;
+                    return 0;
+                }
 
-                    if (wParam == DBT_DEVICEARRIVAL)
+                case WM_RENDERFORMAT:
+                {
+                    WindowsClipboard::Render((UINT)wParam);
+                    return 0;
+                }
+
+                case WM_RENDERALLFORMATS:
+                {
+                    WindowsClipboard::RenderAll();
+                    return 0;
+                }
+
+                case WM_DESTROYCLIPBOARD:
+                {
+                    WindowsClipboard::Release();
+                    return 0;
+                }
+
+                case WM_TIMER:
+                {
+                    if (wParam == CPP_GLFW_CURSOR_TIMER)
                     {
-                        DEV_BROADCAST_HDR* dbh = (DEV_BROADCAST_HDR*)lParam;
-                        if (dbh && dbh->dbch_devicetype == DBT_DEVTYP_DEVICEINTERFACE)
-                        {
-                            CPP_GLFW_TRACE("DetectJoystickConnection");
-                            //DetectJoystickConnection();
-                        }
+                        WindowsCursor::Animate();
+                        return 0;
                     }
-                    else if (wParam == DBT_DEVICEREMOVECOMPLETE)
+                    break;
+                }
+
+                case WM_DEVICECHANGE:
+                {
+                    if (!Input::s_JoysticksInitialized)
+                    {
+                        break;
+                    }
+
+                    if (wParam == DBT_DEVICEARRIVAL
+                        || wParam == DBT_DEVICEREMOVECOMPLETE)
                     {
                         DEV_BROADCAST_HDR* dbh = (DEV_BROADCAST_HDR*)lParam;
                         if (dbh && dbh->dbch_devicetype == DBT_DEVTYP_DEVICEINTERFACE)
                         {
-                            CPP_GLFW_TRACE("DetectJoystickDisconnection");
-                            //DetectJoystickDisconnection();
+                            WindowsJoystick::RequestRescan();
                         }
                     }
                     break;
@@ -97,6 +134,8 @@ namespace cpp_glfw
                     return DefWindowProcW(hwnd, uMsg, wParam, lParam);
                 }
             }
+
+            return DefWindowProcW(hwnd, uMsg, wParam, lParam);
         }
     }
 
@@ -125,23 +164,21 @@ namespace cpp_glfw
             return NULL;
         }
 
-        HBITMAP mask = CreateBitmap(image->width, image->height, 1, 1, NULL);
+        //monochrome bitmap rows are word aligned, the mask is only used where the alpha channel is not
+        const int32_t maskStride = ((image->width + 15) / 16) * 2;
+        std::vector<uint8_t> maskBits((size_t)maskStride * image->height);
+        PixelConversion::GenerateMask(image->pixels, image->width * 4, maskBits.data(), maskStride, image->width, image->height);
+
+        HBITMAP mask = CreateBitmap(image->width, image->height, 1, 1, maskBits.data());
         if (!mask)
         {
             CPP_GLFW_ERROR_WIN32("Failed to create a mask bitmap!");
+            DeleteObject(color);
             return NULL;
         }
 
-        uint8_t* source = image->pixels;
-        for (int32_t i = 0; i < image->width * image->height; i++)
-        {
-            target[0] = source[2];
-            target[1] = source[1];
-            target[2] = source[0];
-            target[3] = source[3];
-            target += 4;
-            source += 4;
-        }
+        //icons take straight alpha, so the channels are only swapped
+        PixelConversion::Swizzle(image->pixels, image->width * 4, target, image->width * 4, image->width, image->height, false);
 
         ICONINFO ii = {};
         ii.fIcon = icon;
@@ -170,6 +207,21 @@ namespace cpp_glfw
         return handle;
     }
 
+    /// <summary> Called at the end of PollEvents to deliver the next batch of every drop still in progress </summary>
+    void WindowsWindow::DeliverPendingDrops()
+    {
+        //by index, a drop callback may open a window and grow the vector
+        const std::vector<Window*>& windows = Platform::GetWindows();
+        for (size_t i = 0; i < windows.size(); i++)
+        {
+            WindowsWindow* windowsWindow = (WindowsWindow*)windows[i];
+            if (windowsWindow->m_PendingDrop)
+            {
+                windowsWindow->DeliverDrop();
+            }
+        }
+    }
+
 
 
     ///////////////////////////////////// STATIC CREATE ///////////////////////////////////////
@@ -178,6 +230,10 @@ namespace cpp_glfw
         const WindowConfig* windowConfig, const ContextConfig* contextConfig, const FramebufferConfig* framebufferConfig, Monitor* monitor)
     {
         WindowsWindow* window = new WindowsWindow(title, width, height, windowConfig, contextConfig, framebufferConfig, monitor);
+        if (!window)
+        {
+            return nullptr;
+        }
 
         DWORD style = window->GetStyle();
         DWORD styleEx = window->GetStyleEx();
@@ -231,7 +287,7 @@ namespace cpp_glfw
             GetModuleHandleW(NULL),
             window); //pointer to window object for the window proc
 
-        free(wideTitle);
+        Memory::Free(wideTitle);
 
         if (!windowHandle)
         {
@@ -282,7 +338,15 @@ namespace cpp_glfw
 
         window->PlatformGetSize(&window->m_Width, &window->m_Height);
 
-        if (contextConfig->type == ContextType::Native)
+        if (contextConfig->api == ContextAPI::Software)
+        {
+            if (!WindowsSoftwareContext::CreateContext(window, contextConfig))
+            {
+                delete window;
+                return nullptr;
+            }
+        }
+        else if (contextConfig->type == ContextType::Native)
         {
             if (!WindowsWglContext::Init()
                 || !WindowsWglContext::CreateContext(window, contextConfig, framebufferConfig))
@@ -328,6 +392,11 @@ namespace cpp_glfw
 
     WindowsWindow::~WindowsWindow()
     {
+        if (m_PendingDrop)
+        {
+            DragFinish(m_PendingDrop);
+        }
+
         if (m_Monitor)
         {
             ReleaseMonitor();
@@ -346,7 +415,7 @@ namespace cpp_glfw
 
         if (m_Handle)
         {
-            RemovePropW(m_Handle, CPP_GLFW_WINDOW_PROP);
+            WindowsPlatform::s_WindowHandles.erase(m_Handle);
             DestroyWindow(m_Handle);
             m_Handle = nullptr;
         }
@@ -360,6 +429,11 @@ namespace cpp_glfw
         {
             DestroyIcon(m_SmallIcon);
         }
+
+        if (m_HasIconSet)
+        {
+            IconCache::Release(m_IconSet);
+        }
     }
 
 
@@ -534,26 +608,62 @@ namespace cpp_glfw
 
     void WindowsWindow::PlatformSetTitle(const std::string& title)
     {
-        WCHAR* wideTitle = WindowsPlatform::UTF8ToWideString(title.c_str());
+        const WCHAR* wideTitle = WindowsPlatform::UTF8ToWideScratch(title.c_str());
         if (!wideTitle)
         {
             return;
         }
         SetWindowTextW(m_Handle, wideTitle);
-        free(wideTitle);
     }
 
     void WindowsWindow::PlatformSetIcon(const std::vector<Image*>& images)
+    {
+        //the new set is registered first, so setting the same images again does not free and copy them
+        const bool hadIconSet = m_HasIconSet;
+        const uint64_t previousSet = m_IconSet;
+
+        m_HasIconSet = images.size() > 0;
+
+        if (m_HasIconSet)
+        {
+            m_IconSet = IconCache::Register(images);
+        }
+
+        UpdateIcons();
+
+        if (hadIconSet)
+        {
+            IconCache::Release(previousSet);
+        }
+    }
+
+    /// <summary> Sets the icons at the sizes for the window's DPI, generating the ones the image set does not have </summary>
+    void WindowsWindow::UpdateIcons()
     {
         HICON bigIcon = NULL, smallIcon = NULL;
 
-        if (images.size())
+        if (m_HasIconSet)
         {
-            const Image* bigImage = WindowsWindow::ChooseImage(images, GetSystemMetrics(SM_CXICON), GetSystemMetrics(SM_CYICON));
-            const Image* smallImage = WindowsWindow::ChooseImage(images, GetSystemMetrics(SM_CXSMICON), GetSystemMetrics(SM_CYSMICON));
+            int32_t bigWidth, bigHeight, smallWidth, smallHeight;
 
-            bigIcon = CreateIcon(bigImage, 0, 0, true);
-            smallIcon = CreateIcon(smallImage, 0, 0, true);
+            if (WindowsPlatform::IsWindows10AnniversaryUpdateOrGreater())
+            {
+                const UINT dpi = WindowsPlatform::s_Libs.user32.GetDpiForWindow(m_Handle);
+                bigWidth = WindowsPlatform::s_Libs.user32.GetSystemMetricsForDpi(SM_CXICON, dpi);
+                bigHeight = WindowsPlatform::s_Libs.user32.GetSystemMetricsForDpi(SM_CYICON, dpi);
+                smallWidth = WindowsPlatform::s_Libs.user32.GetSystemMetricsForDpi(SM_CXSMICON, dpi);
+                smallHeight = WindowsPlatform::s_Libs.user32.GetSystemMetricsForDpi(SM_CYSMICON, dpi);
+            }
+            else
+            {
+                bigWidth = GetSystemMetrics(SM_CXICON);
+                bigHeight = GetSystemMetrics(SM_CYICON);
+                smallWidth = GetSystemMetrics(SM_CXSMICON);
+                smallHeight = GetSystemMetrics(SM_CYSMICON);
+            }
+
+            bigIcon = CreateIcon(IconCache::GetIcon(m_IconSet, bigWidth, bigHeight), 0, 0, true);
+            smallIcon = CreateIcon(IconCache::GetIcon(m_IconSet, smallWidth, smallHeight), 0, 0, true);
         }
         else
         {
@@ -574,15 +684,19 @@ namespace cpp_glfw
             DestroyIcon(m_SmallIcon);
         }
 
-        if (images.size())
-        {
-            m_BigIcon = bigIcon;
-            m_SmallIcon = smallIcon;
-        }
+        m_BigIcon = m_HasIconSet ? bigIcon : nullptr;
+        m_SmallIcon = m_HasIconSet ? smallIcon : nullptr;
     }
 
     void WindowsWindow::PlatformSetCursorType(Cursor* cursor)
     {
+        //animated cursors only keep the timer running while they are set on a window
+        if (cursor
+            && !((WindowsCursor*)cursor)->m_Frames.empty())
+        {
+            WindowsCursor::Animate();
+        }
+
         if (IsCursorInContentArea())
         {
             UpdateCursorImage();
@@ -828,6 +942,72 @@ namespace cpp_glfw
         }
     }
 
+    /// <summary> Restyles, moves, resizes and restacks a windowed window with a single SetWindowPos </summary>
+    void WindowsWindow::PlatformCommit(WindowProperty changed, int32_t x, int32_t y, int32_t width, int32_t height)
+    {
+        const bool move = (changed & WindowProperty::Position) != WindowProperty::None;
+        const bool resize = (changed & WindowProperty::Size) != WindowProperty::None;
+        const bool restyle = (changed & WindowProperty::Decorated) != WindowProperty::None;
+        const bool restack = (changed & WindowProperty::Floating) != WindowProperty::None;
+
+        UINT flags = SWP_NOACTIVATE;
+
+        if (restyle)
+        {
+            DWORD style = GetWindowLongW(m_Handle, GWL_STYLE);
+            style &= ~(WS_OVERLAPPEDWINDOW | WS_POPUP);
+            style |= GetStyle();
+            SetWindowLongW(m_Handle, GWL_STYLE, style);
+            flags |= SWP_FRAMECHANGED;
+        }
+
+        //whatever was not changed keeps the current content area, the frame is rebuilt around it
+        RECT rect;
+        GetClientRect(m_Handle, &rect);
+        ClientToScreen(m_Handle, (POINT*)&rect.left);
+        ClientToScreen(m_Handle, (POINT*)&rect.right);
+
+        if (move)
+        {
+            rect.right += x - rect.left;
+            rect.bottom += y - rect.top;
+            rect.left = x;
+            rect.top = y;
+        }
+
+        if (resize)
+        {
+            rect.right = rect.left + width;
+            rect.bottom = rect.top + height;
+        }
+
+        AdjustRect(&rect);
+
+        if (!move
+            && !resize
+            && !restyle)
+        {
+            flags |= SWP_NOMOVE | SWP_NOSIZE;
+        }
+
+        HWND after = HWND_TOP;
+        if (restack)
+        {
+            after = m_Floating
+                ? HWND_TOPMOST
+                : HWND_NOTOPMOST;
+        }
+        else
+        {
+            flags |= SWP_NOZORDER;
+        }
+
+        SetWindowPos(m_Handle, after,
+            rect.left, rect.top,
+            rect.right - rect.left, rect.bottom - rect.top,
+            flags);
+    }
+
     void WindowsWindow::PlatformSetCursor(Cursor* cursor)
     {
         if (IsCursorInContentArea())
@@ -1343,11 +1523,9 @@ namespace cpp_glfw
                 HRAWINPUT ri = (HRAWINPUT)lParam;
 
                 GetRawInputData(ri, RID_INPUT, NULL, &size, sizeof(RAWINPUTHEADER));
-                if (size > (UINT)WindowsPlatform::s_RawInputSize)
+                if (!WindowsPlatform::ReserveRawInput(size))
                 {
-                    free(WindowsPlatform::s_RawInput);
-                    WindowsPlatform::s_RawInput = (RAWINPUT*)calloc(size, 1);
-                    WindowsPlatform::s_RawInputSize = size;
+                    break;
                 }
 
                 size = WindowsPlatform::s_RawInputSize;
@@ -1571,6 +1749,13 @@ namespace cpp_glfw
 
             case WM_PAINT:
             {
+                //a software framebuffer can repaint exposed areas without waiting for the application
+                if (m_Context
+                    && m_Context->m_API == ContextAPI::Software)
+                {
+                    WindowsSoftwareContext::PresentFront(this);
+                }
+
                 OnNeedUpdate();
                 break;
             }
@@ -1631,6 +1816,9 @@ namespace cpp_glfw
 
             case WM_DPICHANGED:
             {
+                //the monitor scale changed with it
+                WindowsPlatform::InvalidateMonitors(MonitorProperty::ContentScale);
+
                 const float xScale = HIWORD(wParam) / (float)USER_DEFAULT_SCREEN_DPI;
                 const float yScale = LOWORD(wParam) / (float)USER_DEFAULT_SCREEN_DPI;
 
@@ -1649,6 +1837,12 @@ namespace cpp_glfw
                         SWP_NOACTIVATE | SWP_NOZORDER);
                 }
 
+                //the icon sizes follow the DPI
+                if (m_HasIconSet)
+                {
+                    UpdateIcons();
+                }
+
                 OnContentScaleChanged(xScale, yScale);
                 break;
             }
@@ -1666,10 +1860,13 @@ namespace cpp_glfw
 
             case WM_DROPFILES:
             {
-                HDROP drop = (HDROP)wParam;
-                const int count = DragQueryFileW(drop, 0xffffffff, NULL, 0);
+                //a new drop finishes delivering the previous one first, so batches never interleave
+                while (m_PendingDrop)
+                {
+                    DeliverDrop();
+                }
 
-                char** paths = (char**)calloc(count, sizeof(char*));
+                HDROP drop = (HDROP)wParam;
 
                 // Move the mouse to the position of the drop
                 POINT pt;
@@ -1677,26 +1874,12 @@ namespace cpp_glfw
 
                 OnCursorPositionChanged(pt.x, pt.y);
 
-                for (int32_t i = 0; i < count; i++)
-                {
-                    const UINT length = DragQueryFileW(drop, i, NULL, 0);
-                    WCHAR* buffer = (WCHAR*)calloc((size_t)length + 1, sizeof(WCHAR));
-
-                    DragQueryFileW(drop, i, buffer, length + 1);
-                    paths[i] = WindowsPlatform::WideStringToUTF8(buffer);
-
-                    free(buffer);
-                }
-
-                OnDrop(count, (const char**)paths);
-
-                for (int32_t i = 0; i < count; i++)
-                {
-                    free(paths[i]);
-                }
-                free(paths);
+                m_PendingDrop = drop;
+                m_PendingDropIndex = 0;
+                m_PendingDropCount = DragQueryFileW(drop, 0xffffffff, NULL, 0);
 
-                DragFinish(drop);
+                //the first batch is delivered right away, the rest from the following PollEvents
+                DeliverDrop();
                 return 0;
             }
         }
@@ -1898,6 +2081,45 @@ namespace cpp_glfw
         }
     }
 
+    /// <summary> Converts the next batch of the pending drop straight into the drop payload arena </summary>
+    void WindowsWindow::DeliverDrop()
+    {
+        const uint32_t remaining = m_PendingDropCount - m_PendingDropIndex;
+        const uint32_t count = m_DropBatchSize ? std::min(m_DropBatchSize, remaining) : remaining;
+
+        m_DropPayload.Begin(m_PendingDropIndex, m_PendingDropCount);
+
+        for (uint32_t i = m_PendingDropIndex; i < m_PendingDropIndex + count; i++)
+        {
+            const UINT length = DragQueryFileW(m_PendingDrop, i, NULL, 0);
+            WCHAR* path = WindowsPlatform::ReserveWideScratch((size_t)length + 1);
+
+            //a UTF-16 unit never needs more than three UTF-8 bytes
+            char* target = m_DropPayload.Reserve(length * 3);
+            int32_t written = 0;
+
+            //a path that cannot be read is delivered empty, so the indices still match the drop
+            if (path
+                && length)
+            {
+                DragQueryFileW(m_PendingDrop, i, path, length + 1);
+                written = WideCharToMultiByte(CP_UTF8, 0, path, (int)length, target, (int)length * 3, NULL, NULL);
+            }
+
+            m_DropPayload.Commit((uint32_t)std::max(written, 0));
+        }
+
+        m_PendingDropIndex += count;
+
+        if (m_PendingDropIndex >= m_PendingDropCount)
+        {
+            DragFinish(m_PendingDrop);
+            m_PendingDrop = nullptr;
+        }
+
+        OnDrop(&m_DropPayload);
+    }
+
     void WindowsWindow::UpdateClipRect(bool clipToWindow)
     {
         if (clipToWindow)
@@ -10,6 +10,8 @@ namespace cpp_glfw
         HWND m_Handle = nullptr;
         HICON m_SmallIcon = nullptr;
         HICON m_BigIcon = nullptr;
+        uint64_t m_IconSet = 0; //icon cache key of the images from the last SetIcon
+        bool m_HasIconSet = false;
         bool m_Minimized = false;
         bool m_Maximized = false;
         bool m_ScaleToMonitor = false;
@@ -20,11 +22,15 @@ namespace cpp_glfw
         int32_t m_LastCursorPositionX = 0;
         int32_t m_LastCursorPositionY = 0;
         WCHAR m_HighSurrogate = {}; //the last received high surrogate when decoding pairs of UTF-16 messages
+        HDROP m_PendingDrop = nullptr; //drop still being delivered in batches
+        uint32_t m_PendingDropIndex = 0;
+        uint32_t m_PendingDropCount = 0;
 
     public: CPP_GLFW_INTERNAL_API
         static void GetFullSize(DWORD style, DWORD styleEx, int contentWidth, int contentHeight, int* fullWidth, int* fullHeight, UINT dpi);
         static LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
         static HICON CreateIcon(const Image* image, int32_t xHot, int32_t yHot, bool icon);
+        static void DeliverPendingDrops();
 
     public:
         WindowsWindow(const std::string& title, int32_t width, int32_t height,
@@ -33,6 +39,8 @@ namespace cpp_glfw
         virtual ~WindowsWindow();
         friend class Window;
         friend class WindowsWglContext;
+        friend class WindowsSoftwareContext;
+        friend class WindowsCursor;
         friend class EglContext;
 
     private: CPP_GLFW_PLATFORM_API
@@ -65,6 +73,7 @@ namespace cpp_glfw
         void PlatformSetResizable(bool value) override;
         void PlatformSetMousePassThrough(bool value) override;
         void PlatformSetMonitor(Monitor* monitor, int32_t x, int32_t y, int32_t width, int32_t height, int32_t refreshRate) override;
+        void PlatformCommit(WindowProperty changed, int32_t x, int32_t y, int32_t width, int32_t height) override;
         void PlatformSetCursor(Cursor* cursor) override;
         void PlatformSetCursorPosition(double x, double y) override;
         void PlatformSetCursorMode(CursorMode mode) override;
@@ -89,6 +98,7 @@ namespace cpp_glfw
         void ApplyAspectRatio(int32_t edge, RECT* rect);
         void SetCursorEnabled(bool enabled);
         void UpdateCursorImage();
+        void UpdateIcons();
         void UpdateClipRect(bool clipToWindow);
         DWORD GetStyle() const;
         DWORD GetStyleEx() const;
@@ -96,5 +106,6 @@ namespace cpp_glfw
         void AdjustRect(RECT* rect) const;
         bool IsCursorInContentArea() const;
         KeyMods GetKeyMods() const;
+        void DeliverDrop();
     };
 }
@@ -0,0 +1,186 @@
+#include "engine/core/Platform.h"
+
+static int32_t s_Failures = 0;
+
+static void Check(bool condition, const char* fixture, const char* what)
+{
+    if (!condition)
+    {
+        std::cout << "[TEST] " << fixture << ": " << what << std::endl;
+        s_Failures++;
+    }
+}
+
+static bool Near(float value, float expected)
+{
+    return fabsf(value - expected) <= 0.01f * fmaxf(1.0f, fabsf(expected));
+}
+
+static bool ReadFixture(const std::string& directory, const char* name, std::vector<uint8_t>& data)
+{
+    const std::string path = directory + "/" + name;
+
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        std::cout << "[TEST] Failed to open " << path << std::endl;
+        s_Failures++;
+        return false;
+    }
+
+    uint8_t buffer[512];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        data.insert(data.end(), buffer, buffer + read);
+    }
+
+    fclose(file);
+    return true;
+}
+
+/// <summary> EDID 1.4 base block with a 1080p timing, name and serial descriptors and a range limit using the max rate offset </summary>
+static void TestBasic(const std::string& directory)
+{
+    const char* fixture = "basic_1080p.bin";
+
+    std::vector<uint8_t> data;
+    if (!ReadFixture(directory, fixture, data))
+    {
+        return;
+    }
+
+    cpp_glfw::EdidInfo info;
+    Check(cpp_glfw::Edid::Parse(data.data(), data.size(), &info), fixture, "parse failed");
+
+    Check(strcmp(info.manufacturer, "DEL") == 0, fixture, "manufacturer");
+    Check(info.productCode == 0xa0b1, fixture, "product code");
+    Check(info.serialNumber == 12345, fixture, "serial number");
+    Check(strcmp(info.name, "TEST MONITOR") == 0, fixture, "name");
+    Check(strcmp(info.serial, "SN0001") == 0, fixture, "serial string");
+    Check(info.version == 1 && info.revision == 4, fixture, "version");
+    Check(info.widthInMillimeters == 600 && info.heightInMillimeters == 340, fixture, "physical size");
+
+    Check(info.hasNativeTiming, fixture, "native timing missing");
+    Check(info.nativeTiming.width == 1920 && info.nativeTiming.height == 1080, fixture, "native size");
+    Check(info.nativeTiming.pixelClock == 148500, fixture, "pixel clock");
+    Check(Near(info.nativeTiming.refreshRate, 60.0f), fixture, "refresh rate");
+    Check(!info.nativeTiming.interlaced, fixture, "interlaced");
+
+    Check(info.minRefreshRate == 48, fixture, "min refresh rate");
+    Check(info.maxRefreshRate == 300, fixture, "max refresh rate with offset");
+    Check(!info.variableRefreshRate, fixture, "variable refresh rate");
+    Check(!info.hdr.present, fixture, "hdr present");
+}
+
+/// <summary> EDID 1.3 base block without timings, the native timing and the HDR metadata come from a CTA-861 extension </summary>
+static void TestCtaHdr(const std::string& directory)
+{
+    const char* fixture = "cta_hdr_4k.bin";
+
+    std::vector<uint8_t> data;
+    if (!ReadFixture(directory, fixture, data))
+    {
+        return;
+    }
+
+    cpp_glfw::EdidInfo info;
+    Check(cpp_glfw::Edid::Parse(data.data(), data.size(), &info), fixture, "parse failed");
+
+    Check(strcmp(info.manufacturer, "SAM") == 0, fixture, "manufacturer");
+    Check(strcmp(info.name, "HDR TV") == 0, fixture, "name");
+    Check(info.serial[0] == '\0', fixture, "serial string should be empty");
+    Check(info.widthInMillimeters == 1210 && info.heightInMillimeters == 680, fixture, "physical size");
+
+    Check(info.hasNativeTiming, fixture, "native timing missing");
+    Check(info.nativeTiming.width == 3840 && info.nativeTiming.height == 2160, fixture, "native size");
+    Check(info.nativeTiming.pixelClock == 594000, fixture, "pixel clock");
+    Check(Near(info.nativeTiming.refreshRate, 60.0f), fixture, "refresh rate");
+
+    Check(info.hdr.present, fixture, "hdr missing");
+    Check(info.hdr.traditionalSdr && info.hdr.traditionalHdr && info.hdr.pq && info.hdr.hlg, fixture, "eotfs");
+    Check(Near(info.hdr.maxLuminance, 400.0f), fixture, "max luminance");
+    Check(Near(info.hdr.maxFrameAverageLuminance, 200.0f), fixture, "max frame average luminance");
+    Check(Near(info.hdr.minLuminance, 400.0f * (128.0f / 255.0f) * (128.0f / 255.0f) / 100.0f), fixture, "min luminance");
+}
+
+/// <summary> DisplayID 1.3 extension whose preferred timing replaces the base block one and whose range enables VRR </summary>
+static void TestDisplayIdVrr(const std::string& directory)
+{
+    const char* fixture = "displayid_vrr.bin";
+
+    std::vector<uint8_t> data;
+    if (!ReadFixture(directory, fixture, data))
+    {
+        return;
+    }
+
+    cpp_glfw::EdidInfo info;
+    Check(cpp_glfw::Edid::Parse(data.data(), data.size(), &info), fixture, "parse failed");
+
+    Check(strcmp(info.manufacturer, "AUO") == 0, fixture, "manufacturer");
+    Check(strcmp(info.name, "VRR PANEL") == 0, fixture, "name");
+
+    Check(info.hasNativeTiming, fixture, "native timing missing");
+    Check(info.nativeTiming.width == 2560 && info.nativeTiming.height == 1440, fixture, "preferred DisplayID size");
+    Check(info.nativeTiming.pixelClock == 241500, fixture, "pixel clock");
+    Check(Near(info.nativeTiming.refreshRate, 59.95f), fixture, "refresh rate");
+
+    Check(info.minRefreshRate == 48 && info.maxRefreshRate == 165, fixture, "refresh rate range");
+    Check(info.variableRefreshRate, fixture, "variable refresh rate");
+}
+
+/// <summary> Damaged blobs are rejected and the cache hands out one result per distinct blob </summary>
+static void TestRejectAndCache(const std::string& directory)
+{
+    const char* fixture = "basic_1080p.bin";
+
+    std::vector<uint8_t> data;
+    if (!ReadFixture(directory, fixture, data))
+    {
+        return;
+    }
+
+    cpp_glfw::EdidInfo info;
+    Check(!cpp_glfw::Edid::Parse(data.data(), 127, &info), fixture, "truncated blob accepted");
+
+    std::vector<uint8_t> damaged = data;
+    damaged[20] ^= 0x01;
+    Check(!cpp_glfw::Edid::Parse(damaged.data(), damaged.size(), &info), fixture, "bad checksum accepted");
+
+    std::vector<uint8_t> other;
+    if (!ReadFixture(directory, "displayid_vrr.bin", other))
+    {
+        return;
+    }
+
+    const cpp_glfw::EdidInfo* first = cpp_glfw::Edid::Get(data.data(), data.size());
+    const cpp_glfw::EdidInfo* again = cpp_glfw::Edid::Get(data.data(), data.size());
+    const cpp_glfw::EdidInfo* different = cpp_glfw::Edid::Get(other.data(), other.size());
+
+    Check(first && first == again, fixture, "same blob not shared");
+    Check(different && different != first && strcmp(different->name, "VRR PANEL") == 0, fixture, "different blob shared");
+    Check(!cpp_glfw::Edid::Get(damaged.data(), damaged.size()), fixture, "bad checksum cached");
+
+    cpp_glfw::Edid::Terminate();
+}
+
+/// <summary> Parses the EDID fixtures, the first argument overrides the fixture directory </summary>
+int main(int argc, char** argv)
+{
+    const std::string directory = argc > 1 ? argv[1] : "fixtures/edid";
+
+    TestBasic(directory);
+    TestCtaHdr(directory);
+    TestDisplayIdVrr(directory);
+    TestRejectAndCache(directory);
+
+    if (s_Failures)
+    {
+        std::cout << "[TEST] FAILED, " << s_Failures << " checks" << std::endl;
+        return 1;
+    }
+
+    std::cout << "[TEST] PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include "engine/core/Platform.h"
+
+#include <windows.h>
+
+//the posted message queue of a thread holds 10000 messages, so the messages are posted and pumped in batches
+static const int32_t BatchSize = 1000;
+static const int32_t BatchCount = 100;
+
+static size_t s_TextBytes = 0;
+
+static void OnKey(cpp_glfw::Window* window, cpp_glfw::Key key, int32_t scancode, cpp_glfw::KeyState state, cpp_glfw::KeyMods mods)
+{
+}
+static void OnChar(cpp_glfw::Window* window, uint32_t codepoint)
+{
+}
+static void OnText(cpp_glfw::Window* window, const char* text, size_t length)
+{
+    s_TextBytes += length;
+}
+static void OnTextMods(cpp_glfw::Window* window, const char* text, size_t length, const cpp_glfw::KeyMods* mods, size_t count)
+{
+}
+static void OnCursorPosition(cpp_glfw::Window* window, double x, double y)
+{
+}
+static void OnMouseButton(cpp_glfw::Window* window, cpp_glfw::MouseButton button, cpp_glfw::KeyState state, cpp_glfw::KeyMods mods)
+{
+}
+static void OnScroll(cpp_glfw::Window* window, double xOffset, double yOffset)
+{
+}
+
+/// <summary>
+/// Posts one batch of synthetic input, cycling through the messages the event loop handles most.
+/// WM_INPUT carries no raw input handle, so it only exercises the dispatch of the message.
+/// </summary>
+static bool PostBatch(HWND handle)
+{
+    for (int32_t i = 0; i < BatchSize; i++)
+    {
+        const UINT scancode = MapVirtualKeyW('A' + i % 26, MAPVK_VK_TO_VSC);
+        const LPARAM position = MAKELPARAM(i % 640, i % 480);
+
+        BOOL posted = FALSE;
+        switch (i % 8)
+        {
+            case 0: posted = PostMessageW(handle, WM_KEYDOWN, 'A' + i % 26, 1 | (scancode << 16)); break;
+            case 1: posted = PostMessageW(handle, WM_CHAR, L'a' + i % 26, 1 | (scancode << 16)); break;
+            case 2: posted = PostMessageW(handle, WM_KEYUP, 'A' + i % 26, 1 | (scancode << 16) | (1u << 30) | (1u << 31)); break;
+            case 3: posted = PostMessageW(handle, WM_MOUSEMOVE, 0, position); break;
+            case 4: posted = PostMessageW(handle, WM_LBUTTONDOWN, MK_LBUTTON, position); break;
+            case 5: posted = PostMessageW(handle, WM_LBUTTONUP, 0, position); break;
+            case 6: posted = PostMessageW(handle, WM_MOUSEWHEEL, MAKEWPARAM(0, WHEEL_DELTA), position); break;
+            case 7: posted = PostMessageW(handle, WM_INPUT, RIM_INPUT, 0); break;
+        }
+
+        if (!posted)
+        {
+            std::cout << "[TEST] Failed to post message " << i << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// <summary>
+/// Checks that the event loop does not allocate once warmed up.
+/// A hidden window receives 100k synthetic key, text and mouse messages and the allocation count of every tag
+/// has to stay the same across the PollEvents calls that deliver them.
+/// </summary>
+int main(int argc, char** argv)
+{
+    if (!cpp_glfw::Platform::Init())
+    {
+        std::cout << "[TEST] Failed to initialize the platform" << std::endl;
+        return 1;
+    }
+
+    cpp_glfw::Platform::s_Hints.window.visible = false;
+    cpp_glfw::Platform::s_Hints.window.focused = false;
+    cpp_glfw::Platform::s_Hints.context.api = cpp_glfw::ContextAPI::None;
+
+    cpp_glfw::Window* window = cpp_glfw::Platform::OpenWindow("Event allocation test", 640, 480, nullptr);
+    if (!window)
+    {
+        std::cout << "[TEST] Failed to open the window" << std::endl;
+        cpp_glfw::Platform::Terminate();
+        return 1;
+    }
+
+    window->SetKeyCallback(OnKey);
+    window->SetCharCallback(OnChar);
+    window->SetTextCallback(OnText);
+    window->SetTextModsCallback(OnTextMods);
+    window->SetCursorPositionCallback(OnCursorPosition);
+    window->SetMouseButtonCallback(OnMouseButton);
+    window->SetScrollCallback(OnScroll);
+
+    HWND handle = (HWND)window->GetNativeHandle();
+
+    //one full batch sizes the text buffers and the raw input buffer
+    if (!PostBatch(handle))
+    {
+        cpp_glfw::Platform::Terminate();
+        return 1;
+    }
+    cpp_glfw::Platform::PollEvents();
+
+    const uint64_t warmedUp = cpp_glfw::Memory::GetTotalStats().allocationCount;
+    s_TextBytes = 0;
+
+    bool passed = true;
+    for (int32_t batch = 0; batch < BatchCount && passed; batch++)
+    {
+        passed = PostBatch(handle);
+        cpp_glfw::Platform::PollEvents();
+    }
+
+    const uint64_t allocations = cpp_glfw::Memory::GetTotalStats().allocationCount - warmedUp;
+
+    //every WM_CHAR has to reach the text callback, otherwise the loop above did not run the text path
+    const size_t expectedText = (size_t)BatchCount * BatchSize / 8;
+
+    std::cout << "[TEST] Messages: " << BatchCount * BatchSize << std::endl;
+    std::cout << "[TEST] Text bytes: " << s_TextBytes << " of " << expectedText << std::endl;
+    std::cout << "[TEST] Allocations after warm up: " << allocations << std::endl;
+
+    cpp_glfw::Platform::Terminate();
+
+    if (!passed
+        || allocations != 0
+        || s_TextBytes != expectedText)
+    {
+        std::cout << "[TEST] FAILED" << std::endl;
+        return 1;
+    }
+
+    std::cout << "[TEST] PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include "engine/core/Platform.h"
+
+#include <chrono>
+
+using namespace cpp_glfw;
+
+static const int32_t PollRate = 1000; //Hz
+static const int32_t Seconds = 60; //simulated time
+static const int32_t Repeats = 5; //the best run is reported
+
+/// <summary> Two radial sticks with smoothing and two axial cubic triggers, the rest of the lanes keep the default </summary>
+static void Configure()
+{
+    JoystickConditioning::Init();
+
+    for (int32_t jid = 0; jid < CPP_GLFW_JOYSTICK_COUNT; jid++)
+    {
+        JoystickAxisConditioning left = JoystickAxisConditioning::Radial(1, 0.1f, 0.95f, ResponseCurve::Quadratic);
+        JoystickAxisConditioning right = JoystickAxisConditioning::Radial(3, 0.1f, 0.95f, ResponseCurve::Quadratic);
+        left.smoothing = 0.5f;
+        right.smoothing = 0.5f;
+
+        JoystickConditioning::SetConditioning(jid, 0, left);
+        JoystickConditioning::SetConditioning(jid, 1, JoystickAxisConditioning::Radial(0, 0.1f, 0.95f, ResponseCurve::Quadratic));
+        JoystickConditioning::SetConditioning(jid, 2, right);
+        JoystickConditioning::SetConditioning(jid, 3, JoystickAxisConditioning::Radial(2, 0.1f, 0.95f, ResponseCurve::Quadratic));
+        JoystickConditioning::SetConditioning(jid, 4, JoystickAxisConditioning::Axial(0.05f, 1.0f, ResponseCurve::Cubic));
+        JoystickConditioning::SetConditioning(jid, 5, JoystickAxisConditioning::Axial(0.05f, 1.0f, ResponseCurve::Cubic));
+    }
+}
+
+/// <summary> Feeds every axis of every joystick a sine sweep, one tick per poll, and returns the time spent in Process </summary>
+static double Run(const std::vector<float>& sweep, float* checksum)
+{
+    const int32_t ticks = PollRate * Seconds;
+    std::chrono::nanoseconds elapsed(0);
+
+    for (int32_t tick = 0; tick < ticks; tick++)
+    {
+        for (int32_t jid = 0; jid < CPP_GLFW_JOYSTICK_COUNT; jid++)
+        {
+            for (int32_t axis = 0; axis < CPP_GLFW_JOYSTICK_MAX_AXES; axis++)
+            {
+                const size_t phase = (size_t)(tick + jid * 37 + axis * 11) % sweep.size();
+                JoystickConditioning::SetInput(jid, axis, sweep[phase]);
+            }
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        JoystickConditioning::Process();
+        elapsed += std::chrono::steady_clock::now() - start;
+
+        //keeps the outputs alive so the pass is not optimized away
+        *checksum += JoystickConditioning::GetOutput(tick % CPP_GLFW_JOYSTICK_COUNT)[tick % CPP_GLFW_JOYSTICK_MAX_AXES];
+    }
+
+    return std::chrono::duration<double, std::nano>(elapsed).count() / ticks;
+}
+
+/// <summary> Times the conditioning of 16 joysticks x 8 axes polled at 1 kHz, fails when a pass does not fit the poll interval </summary>
+int main()
+{
+    Configure();
+
+    std::vector<float> sweep(977);
+    for (size_t i = 0; i < sweep.size(); i++)
+    {
+        sweep[i] = sinf(6.2831853f * i / sweep.size());
+    }
+
+    float checksum = 0.0f;
+    double best = DBL_MAX;
+    for (int32_t i = 0; i < Repeats; i++)
+    {
+        best = std::min(best, Run(sweep, &checksum));
+    }
+
+    const double budget = 1e9 / PollRate;
+
+    std::cout << "[BENCH] " << CPP_GLFW_JOYSTICK_COUNT << " joysticks x " << CPP_GLFW_JOYSTICK_MAX_AXES << " axes at "
+        << PollRate << " Hz, " << Seconds << " s simulated" << std::endl;
+    std::cout << "[BENCH] Process: " << best << " ns per pass, "
+        << best / CPP_GLFW_JOYSTICK_AXIS_LANES << " ns per axis, "
+        << 100.0 * best / budget << "% of the poll interval" << std::endl;
+    std::cout << "[BENCH] checksum " << checksum << std::endl;
+
+    return best < budget ? 0 : 1;
+}
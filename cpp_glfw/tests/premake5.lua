@@ -0,0 +1,78 @@
+-- every test or benchmark is its own console app built from the library sources, it passes when it returns 0
+function cpp_glfw_test(name, sources)
+    project (name)
+        kind "ConsoleApp"
+        language "C++"
+        cppdialect "C++17"
+        staticruntime "on"
+
+        targetdir ("%{wks.location}/bin/" .. outputdir .. "/%{prj.name}")
+        objdir ("%{wks.location}/bin-int/" .. outputdir .. "/%{prj.name}")
+
+        debugdir "%{prj.location}"
+
+        defines
+        {
+            "_CRT_SECURE_NO_WARNINGS",
+        }
+
+        includedirs
+        {
+            "../src",
+        }
+
+        files (sources)
+
+        files
+        {
+            "../src/engine/**.h",
+            "../src/engine/**.c",
+            "../src/engine/**.hpp",
+            "../src/engine/**.cpp",
+
+            "../src/external/**.h",
+            "../src/external/**.c",
+            "../src/external/**.hpp",
+            "../src/external/**.cpp",
+        }
+
+        filter { "system:Windows" }
+            systemversion "latest"
+            files
+            {
+                "../src/platform/windows/**.h",
+                "../src/platform/windows/**.c",
+                "../src/platform/windows/**.hpp",
+                "../src/platform/windows/**.cpp",
+            }
+            links
+            {
+                "opengl32.lib"
+            }
+
+        filter { "configurations:Debug" }
+            defines "CPP_GLFW_DEBUG"
+            runtime "Debug"
+            symbols "on"
+
+        filter { "configurations:Release" }
+            defines "CPP_GLFW_RELEASE"
+            runtime "Release"
+            optimize "on"
+
+        filter { "configurations:Dist" }
+            defines "CPP_GLFW_DIST"
+            runtime "Release"
+            optimize "on"
+
+        filter {}
+end
+
+group "tests"
+    cpp_glfw_test("EventAllocationTest", { "EventAllocationTest.cpp" })
+    cpp_glfw_test("EdidTest", { "EdidTest.cpp", "fixtures/edid/**.bin" })
+group ""
+
+group "benchmarks"
+    cpp_glfw_test("JoystickConditioningBenchmark", { "JoystickConditioningBenchmark.cpp" })
+group ""
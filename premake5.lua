@@ -17,4 +17,4 @@ workspace "cpp_glfw"
 outputdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
 
 include "cpp_glfw"
-
+include "cpp_glfw/tests"